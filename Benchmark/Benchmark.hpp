@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Core/Time.hpp"
+
+void MemoryBenchmark();
+void SortBenchmark();
+void FormatBenchmark();
+
+/// <summary>
+/// Runs function repeats times and returns the fastest run in seconds, the first run usually pays for page faults and cold caches
+/// </summary>
+template<class Function>
+inline F64 Measure(Function&& function, U32 repeats = 5)
+{
+	F64 best = F64_MAX;
+
+	for (U32 i = 0; i < repeats; ++i)
+	{
+		F64 start = Time::AbsoluteTime();
+		function();
+		F64 time = Time::AbsoluteTime() - start;
+
+		if (time < best) { best = time; }
+	}
+
+	return best;
+}
+
+/// <summary>
+/// Millions of operations per second, rounded to two decimals so the log stays readable
+/// </summary>
+inline F64 Rate(U64 operations, F64 seconds)
+{
+	return (F64)(U64)(operations / seconds / 10000.0 + 0.5) / 100.0;
+}
+
+//Results are folded into this so the optimizer can't drop the work being measured
+inline volatile U64 benchmarkSink = 0;
@@ -0,0 +1,102 @@
+#include "Benchmark.hpp"
+
+#include "Containers/String.hpp"
+#include "Containers/Vector.hpp"
+#include "Math/Random.hpp"
+#include "Core/Logger.hpp"
+
+#include <charconv>
+
+static constexpr U64 Count = 1000000;
+static constexpr U64 Stride = 32;	//Every formatted value gets a slot this big in the text that gets parsed
+
+//Folds the value's bits into the checksum so the parsed value can't be optimized away
+template<class Type>
+static U64 Bits(Type value)
+{
+	U64 bits = 0;
+	memcpy(&bits, &value, sizeof(Type));
+	return bits;
+}
+
+/// <summary>
+/// Formats and parses Count values of Type with String and with std::to_chars/from_chars, both parse the same text written by String::Format
+/// </summary>
+template<class Type, class Generate>
+static void Compare(const C8* name, Generate&& generate)
+{
+	Vector<Type> values(Count, Type{});
+	for (Type& value : values) { value = generate(); }
+
+	Vector<C8> text(Count * Stride, 0);
+	Vector<U8> lengths(Count, 0);
+	for (U64 i = 0; i < Count; ++i) { lengths[i] = (U8)String::Format(text.Data() + i * Stride, values[i]); }
+
+	F64 format = Measure([&] {
+		C8 buffer[Stride];
+		U64 total = 0;
+		for (const Type& value : values) { total += String::Format(buffer, value); }
+		benchmarkSink = benchmarkSink + total;
+	});
+
+	F64 toChars = Measure([&] {
+		C8 buffer[Stride];
+		U64 total = 0;
+		for (const Type& value : values) { total += std::to_chars(buffer, buffer + Stride, value).ptr - buffer; }
+		benchmarkSink = benchmarkSink + total;
+	});
+
+	F64 parse = Measure([&] {
+		U64 total = 0;
+		for (U64 i = 0; i < Count; ++i)
+		{
+			Type value{};
+			total += String::Parse(text.Data() + i * Stride, lengths[i], value) ^ Bits(value);
+		}
+		benchmarkSink = benchmarkSink + total;
+	});
+
+	F64 fromChars = Measure([&] {
+		U64 total = 0;
+		for (U64 i = 0; i < Count; ++i)
+		{
+			const C8* string = text.Data() + i * Stride;
+			Type value{};
+			total += (std::from_chars(string, string + lengths[i], value).ptr - string) ^ Bits(value);
+		}
+		benchmarkSink = benchmarkSink + total;
+	});
+
+	Logger::Info("  ", name, ": Format ", Rate(Count, format), ", to_chars ", Rate(Count, toChars),
+		", Parse ", Rate(Count, parse), ", from_chars ", Rate(Count, fromChars));
+}
+
+//Any finite value, these mostly need the full 17 or 9 significant digits
+template<class Type, class Raw>
+static Type RandomFinite()
+{
+	constexpr U64 ExponentBits = sizeof(Type) == 8 ? 0x7FF0000000000000ull : 0x7F800000ull;
+
+	Raw bits = (Raw)Random::RandomInt();
+	if ((bits & ExponentBits) == ExponentBits) { bits &= ~(Raw)(ExponentBits & (ExponentBits >> 1)); }
+
+	Type value;
+	memcpy(&value, &bits, sizeof(Type));
+	return value;
+}
+
+/// <summary>
+/// String's number formatting and parsing against std::to_chars and std::from_chars, shortest round trip for floats
+/// </summary>
+void FormatBenchmark()
+{
+	Random::SeedRandom(1234);
+
+	Logger::Info("Format, Million Numbers Per Second:");
+
+	Compare<F64>("F64 Random Bits", [] { return RandomFinite<F64, U64>(); });
+	Compare<F64>("F64 Three Decimals", [] { return (F64)(Random::RandomInt() % 1000000) / 1000.0; });
+	Compare<F32>("F32 Random Bits", [] { return RandomFinite<F32, U32>(); });
+	Compare<I64>("I64", [] { return (I64)Random::RandomInt() >> (Random::RandomInt() % 64); });
+	Compare<U32>("U32", [] { return (U32)Random::RandomInt() >> (Random::RandomInt() % 32); });
+}
@@ -0,0 +1,31 @@
+#include "Benchmark.hpp"
+
+#include "Core/Logger.hpp"
+
+#include <string.h>
+
+struct Suite
+{
+	const C8* name;
+	void(*run)();
+};
+
+static constexpr Suite Suites[]{
+	{ "memory", MemoryBenchmark },
+	{ "sort", SortBenchmark },
+	{ "format", FormatBenchmark },
+};
+
+//Runs every suite, or only the ones named on the command line
+int main(int argc, char** argv)
+{
+	for (const Suite& suite : Suites)
+	{
+		bool selected = argc < 2;
+		for (int i = 1; i < argc && !selected; ++i) { selected = strcmp(argv[i], suite.name) == 0; }
+
+		if (selected) { suite.run(); }
+	}
+
+	return 0;
+}
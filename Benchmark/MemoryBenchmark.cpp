@@ -0,0 +1,91 @@
+#include "Benchmark.hpp"
+
+#include "Platform/Memory.hpp"
+#include "Core/Logger.hpp"
+
+#include <thread>
+#include <stdlib.h>
+
+static constexpr U32 MaxThreads = 32;
+static constexpr U32 OperationsPerThread = 1 << 20;
+static constexpr U32 LiveAllocations = 256;	//Held by each thread at once, so slots are freed out of order like in the engine
+
+//Spread over the 16b to 1kb classes, where the magazines sit
+static constexpr U64 Sizes[]{ 16, 24, 48, 64, 100, 200, 400, 900 };
+static constexpr U32 SizeCount = sizeof(Sizes) / sizeof(Sizes[0]);
+
+//Each thread replaces a random live allocation per step, one Free and one Allocate
+template<class Allocate, class Free>
+static void Churn(Allocate&& allocate, Free&& free)
+{
+	U8* pointers[LiveAllocations]{};
+	U32 state = 0x9E3779B9;
+	U64 touched = 0;
+
+	for (U32 i = 0; i < OperationsPerThread; ++i)
+	{
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+
+		U8*& pointer = pointers[state % LiveAllocations];
+		free(pointer);
+		pointer = allocate(Sizes[(state >> 8) % SizeCount]);
+
+		*pointer = (U8)i;
+		touched += *pointer;
+	}
+
+	for (U8*& pointer : pointers) { free(pointer); }
+
+	benchmarkSink = benchmarkSink + touched;
+}
+
+static void MemoryChurn()
+{
+	Churn([](U64 size) { U8* pointer = nullptr; Memory::Allocate(&pointer, size); return pointer; },
+		[](U8*& pointer) { Memory::Free(&pointer); });
+}
+
+static void SystemChurn()
+{
+	Churn([](U64 size) { return (U8*)malloc(size); },
+		[](U8*& pointer) { free(pointer); pointer = nullptr; });
+}
+
+static F64 RunThreads(U32 threadCount, void(*workload)())
+{
+	return Measure([=] {
+		std::thread threads[MaxThreads];
+
+		for (U32 i = 0; i < threadCount; ++i) { threads[i] = std::thread(workload); }
+		for (U32 i = 0; i < threadCount; ++i) { threads[i].join(); }
+	}, 3);
+}
+
+/// <summary>
+/// Allocation and free throughput of Memory against malloc from 1 to N threads, the total rate should keep climbing with the
+/// thread count as long as the magazines keep threads off the regions' locks
+/// </summary>
+void MemoryBenchmark()
+{
+	U32 maxThreads = std::thread::hardware_concurrency();
+	if (maxThreads == 0) { maxThreads = 4; }
+	if (maxThreads > MaxThreads) { maxThreads = MaxThreads; }
+
+	Logger::Info("Memory, Million Allocate/Free Pairs Per Second, ", OperationsPerThread, " Per Thread:");
+
+	for (U32 threads = 1; ; threads *= 2)
+	{
+		if (threads > maxThreads) { threads = maxThreads; }
+
+		U64 operations = (U64)threads * OperationsPerThread;
+
+		F64 memory = RunThreads(threads, MemoryChurn);
+		F64 system = RunThreads(threads, SystemChurn);
+
+		Logger::Info("  ", threads, " Threads: Memory ", Rate(operations, memory), ", malloc ", Rate(operations, system));
+
+		if (threads == maxThreads) { break; }
+	}
+}
@@ -0,0 +1,80 @@
+#include "Benchmark.hpp"
+
+#include "Containers/Vector.hpp"
+#include "Math/Random.hpp"
+#include "Core/Logger.hpp"
+
+#include <algorithm>
+
+//A draw call sorted back to front, what render ordering sorts
+struct DrawKey
+{
+	F32 depth;
+	U32 entity;
+	U64 payload;
+};
+
+static constexpr U64 Sizes[]{ 10000, 100000, 1000000 };
+
+static U64 Checksum(U32 value) { return value; }
+static U64 Checksum(const DrawKey& key) { return key.entity; }
+
+//Every run sorts a fresh copy of the same shuffled input, the copy is part of every timing so the columns stay comparable
+template<class Type, class Sort>
+static F64 TimeSort(const Vector<Type>& input, Vector<Type>& work, Sort&& sort)
+{
+	F64 time = Measure([&] {
+		memcpy(work.Data(), input.Data(), sizeof(Type) * input.Size());
+		sort(work);
+	});
+
+	benchmarkSink = benchmarkSink + Checksum(work[input.Size() / 2]);
+	return time;
+}
+
+static void SortIntegers(U64 size)
+{
+	Vector<U32> input(size, 0);
+	Vector<U32> work(size, 0);
+	for (U32& value : input) { value = (U32)Random::RandomInt(); }
+
+	F64 intro = TimeSort(input, work, [](Vector<U32>& values) { values.Sort(); });
+	F64 stable = TimeSort(input, work, [](Vector<U32>& values) { values.StableSort(); });
+	F64 radix = TimeSort(input, work, [](Vector<U32>& values) { values.RadixSort(); });
+	F64 standard = TimeSort(input, work, [](Vector<U32>& values) { std::sort(values.begin(), values.end()); });
+	F64 standardStable = TimeSort(input, work, [](Vector<U32>& values) { std::stable_sort(values.begin(), values.end()); });
+
+	Logger::Info("  U32 x ", size, ": Sort ", Rate(size, intro), ", StableSort ", Rate(size, stable), ", RadixSort ", Rate(size, radix),
+		", std::sort ", Rate(size, standard), ", std::stable_sort ", Rate(size, standardStable));
+}
+
+static void SortDrawKeys(U64 size)
+{
+	Vector<DrawKey> input(size, {});
+	Vector<DrawKey> work(size, {});
+	for (U64 i = 0; i < size; ++i) { input[i] = { (F32)Random::RandomUniform() * 1000.0f, (U32)i, Random::RandomInt() }; }
+
+	auto byDepth = [](const DrawKey& a, const DrawKey& b) { return a.depth < b.depth; };
+
+	F64 intro = TimeSort(input, work, [&](Vector<DrawKey>& keys) { keys.Sort(byDepth); });
+	F64 stable = TimeSort(input, work, [&](Vector<DrawKey>& keys) { keys.StableSort(byDepth); });
+	F64 radix = TimeSort(input, work, [](Vector<DrawKey>& keys) { keys.RadixSort([](const DrawKey& key) { return key.depth; }); });
+	F64 standard = TimeSort(input, work, [&](Vector<DrawKey>& keys) { std::sort(keys.begin(), keys.end(), byDepth); });
+	F64 standardStable = TimeSort(input, work, [&](Vector<DrawKey>& keys) { std::stable_sort(keys.begin(), keys.end(), byDepth); });
+
+	Logger::Info("  DrawKey x ", size, ": Sort ", Rate(size, intro), ", StableSort ", Rate(size, stable), ", RadixSort ", Rate(size, radix),
+		", std::sort ", Rate(size, standard), ", std::stable_sort ", Rate(size, standardStable));
+}
+
+/// <summary>
+/// Vector's sorts against std::sort and std::stable_sort on shuffled integers and on 16 byte structs keyed by a float
+/// </summary>
+void SortBenchmark()
+{
+	Random::SeedRandom(1234);
+
+	Logger::Info("Sort, Million Elements Per Second:");
+
+	for (U64 size : Sizes) { SortIntegers(size); }
+	for (U64 size : Sizes) { SortDrawKeys(size); }
+}
@@ -39,6 +39,7 @@ struct AudioCallbacks : public IXAudio2VoiceCallback
 bool Audio::Initialize()
 {
 	Logger::Trace("Initializing Audio...");
+	MemoryTagScope memoryTag(MemoryTag::Audio);
 
 	Platform::OnFocused += Focus;
 
@@ -64,7 +65,7 @@ bool Audio::Initialize()
 	Settings::GetSetting(Settings::MasterVolume, &masterVolume, sizeof(U32));
 
 	freePlaybacks(256);
-	Memory::Allocate(&audioPlaybacks, freePlaybacks.Capacity());
+	Memory::AllocateZeroed(&audioPlaybacks, freePlaybacks.Capacity());
 
 	return true;
 }
@@ -209,8 +210,10 @@ U32 Audio::PlayAudioClip(U32 channelIndex, const ResourceRef<AudioClip>& clip, c
 {
 	if (freePlaybacks.Full())
 	{
-		freePlaybacks.Resize(freePlaybacks.Capacity() * 2);
+		U32 oldCapacity = freePlaybacks.Capacity();
+		freePlaybacks.Resize(oldCapacity * 2);
 		Memory::Reallocate(&audioPlaybacks, freePlaybacks.Capacity());
+		memset(audioPlaybacks + oldCapacity, 0, sizeof(AudioPlayback) * oldCapacity);
 	}
 
 	U32 index = freePlaybacks.GetFree();
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "TypeTraits.hpp"
+
+#include "Hashmap.hpp"
+#include "Multithreading/ThreadSafety.hpp"
+
+#include <atomic>
+
+/// <summary>
+/// Hashmap shared between threads, keys are split across shards by the top bits of their hash and each shard has its own lock.
+/// Values live in their own allocations, so pointers to them stay valid while the shards grow, until their key is removed
+/// </summary>
+template<class Key, class Value, U64 ShardBits = 4>
+struct ConcurrentHashmap
+{
+	ConcurrentHashmap();
+	ConcurrentHashmap(U64 capacity);
+	ConcurrentHashmap(MemoryTag tag, U64 capacity);
+
+	ConcurrentHashmap(const ConcurrentHashmap&) = delete;
+	ConcurrentHashmap(ConcurrentHashmap&&) = delete;
+	ConcurrentHashmap& operator=(const ConcurrentHashmap&) = delete;
+	ConcurrentHashmap& operator=(ConcurrentHashmap&&) = delete;
+
+	~ConcurrentHashmap();
+	void Destroy();
+
+	bool Insert(const Key& key, const Value& value);
+	bool Insert(const Key& key, Value&& value) noexcept;
+
+	/// <summary>
+	/// Gets the value of key, creating it if no thread has yet. Exactly one thread calls create as bool(Value&), outside of any lock,
+	/// the others racing for the same key wait for it and receive the same value, or nullptr if create returned false
+	/// </summary>
+	template<class Create> Value* GetOrInsert(const Key& key, Create&& create);
+
+	/// <summary>
+	/// Gets the value of key, nullptr if it doesn't exist or is still being created
+	/// </summary>
+	Value* Get(const Key& key);
+
+	/// <summary>
+	/// Removes key, the caller must make sure no other thread still uses its value
+	/// </summary>
+	bool Remove(const Key& key);
+
+	/// <summary>
+	/// Calls function as void(Value&) on every created value, one shard locked at a time
+	/// </summary>
+	template<class Function> void ForEach(Function&& function);
+
+	U64 Size() const;
+	bool Empty() const;
+
+	static constexpr inline U64 ShardCount = 1ull << ShardBits;
+
+private:
+	enum class EntryState : U8
+	{
+		Creating,
+		Ready,
+		Failed
+	};
+
+	struct Entry
+	{
+		Value value;
+		std::atomic<EntryState> state;
+		std::atomic<U32> references;	//The creator and any waiters, only counted while the entry is being created
+	};
+
+	struct alignas(CacheLineSize) Shard
+	{
+		SpinLock lock;
+		Hashmap<Key, Entry*> map;
+	};
+
+	Shard& GetShard(U64 hash);
+	Entry* CreateEntry();
+	void Release(Entry* entry);
+
+	Shard shards[ShardCount];
+	U64 size = 0;
+	MemoryTag tag = MemoryTag::Current;
+};
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::ConcurrentHashmap() {}
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::ConcurrentHashmap(U64 capacity)
+{
+	for (Shard& shard : shards) { shard.map.Reserve(capacity / ShardCount); }
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::ConcurrentHashmap(MemoryTag tag, U64 capacity) : tag(tag)
+{
+	for (Shard& shard : shards) { shard.map = Hashmap<Key, Entry*>(tag, capacity / ShardCount); }
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::~ConcurrentHashmap()
+{
+	Destroy();
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline void ConcurrentHashmap<Key, Value, ShardBits>::Destroy()
+{
+	for (Shard& shard : shards)
+	{
+		LockGuard lg(shard.lock);
+
+		for (typename Hashmap<Key, Entry*>::Iterator it = shard.map.begin(), end = shard.map.end(); it != end; ++it)
+		{
+			if (it.Valid()) { Release(*it); }
+		}
+
+		shard.map.Destroy();
+	}
+
+	size = 0;
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline bool ConcurrentHashmap<Key, Value, ShardBits>::Insert(const Key& key, const Value& value)
+{
+	U64 hash = Hash::Any(key);
+	Shard& shard = GetShard(hash);
+
+	LockGuard lg(shard.lock);
+
+	Entry** slot = shard.map.RequestWithHash(key, hash);
+	if (*slot) { return false; }
+
+	Entry* entry = CreateEntry();
+	entry->value = value;
+	entry->state.store(EntryState::Ready, std::memory_order_release);
+	*slot = entry;
+
+	SafeIncrement(&size);
+	return true;
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline bool ConcurrentHashmap<Key, Value, ShardBits>::Insert(const Key& key, Value&& value) noexcept
+{
+	U64 hash = Hash::Any(key);
+	Shard& shard = GetShard(hash);
+
+	LockGuard lg(shard.lock);
+
+	Entry** slot = shard.map.RequestWithHash(key, hash);
+	if (*slot) { return false; }
+
+	Entry* entry = CreateEntry();
+	entry->value = Move(value);
+	entry->state.store(EntryState::Ready, std::memory_order_release);
+	*slot = entry;
+
+	SafeIncrement(&size);
+	return true;
+}
+
+template<class Key, class Value, U64 ShardBits>
+template<class Create>
+inline Value* ConcurrentHashmap<Key, Value, ShardBits>::GetOrInsert(const Key& key, Create&& create)
+{
+	U64 hash = Hash::Any(key);
+	Shard& shard = GetShard(hash);
+
+	Entry* entry;
+	bool creator = false;
+
+	{
+		LockGuard lg(shard.lock);
+
+		//New cells start zeroed, a null entry means no thread has claimed this key yet
+		Entry** slot = shard.map.RequestWithHash(key, hash);
+
+		if (*slot)
+		{
+			entry = *slot;
+			if (entry->state.load(std::memory_order_acquire) == EntryState::Ready) { return &entry->value; }
+
+			//Still being created, hold a reference so a failed entry outlives this thread's wait
+			entry->references.fetch_add(1, std::memory_order_relaxed);
+		}
+		else
+		{
+			entry = CreateEntry();
+			*slot = entry;
+			creator = true;
+			SafeIncrement(&size);
+		}
+	}
+
+	if (creator)
+	{
+		if (create(entry->value))
+		{
+			entry->state.store(EntryState::Ready, std::memory_order_release);
+			return &entry->value;
+		}
+
+		//Unlink first so no new waiters can find the entry, then wake the current ones
+		{
+			LockGuard lg(shard.lock);
+			shard.map.Remove(key);
+		}
+
+		SafeDecrement(&size);
+		entry->state.store(EntryState::Failed, std::memory_order_release);
+	}
+	else
+	{
+		EntryState state;
+		while ((state = entry->state.load(std::memory_order_acquire)) == EntryState::Creating) { Yield(); }
+
+		if (state == EntryState::Ready) { return &entry->value; }
+	}
+
+	//The last thread to let go of a failed entry frees it
+	if (entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1) { Release(entry); }
+
+	return nullptr;
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline Value* ConcurrentHashmap<Key, Value, ShardBits>::Get(const Key& key)
+{
+	U64 hash = Hash::Any(key);
+	Shard& shard = GetShard(hash);
+
+	LockGuard lg(shard.lock);
+
+	Entry** slot = shard.map.GetWithHash(key, hash);
+	if (!slot || (*slot)->state.load(std::memory_order_acquire) != EntryState::Ready) { return nullptr; }
+
+	return &(*slot)->value;
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline bool ConcurrentHashmap<Key, Value, ShardBits>::Remove(const Key& key)
+{
+	U64 hash = Hash::Any(key);
+	Shard& shard = GetShard(hash);
+
+	Entry* entry;
+
+	{
+		LockGuard lg(shard.lock);
+
+		Entry** slot = shard.map.GetWithHash(key, hash);
+		if (!slot || (*slot)->state.load(std::memory_order_acquire) != EntryState::Ready) { return false; }
+
+		entry = *slot;
+		shard.map.Remove(key);
+	}
+
+	SafeDecrement(&size);
+	Release(entry);
+	return true;
+}
+
+template<class Key, class Value, U64 ShardBits>
+template<class Function>
+inline void ConcurrentHashmap<Key, Value, ShardBits>::ForEach(Function&& function)
+{
+	for (Shard& shard : shards)
+	{
+		LockGuard lg(shard.lock);
+
+		for (typename Hashmap<Key, Entry*>::Iterator it = shard.map.begin(), end = shard.map.end(); it != end; ++it)
+		{
+			if (it.Valid() && (*it)->state.load(std::memory_order_acquire) == EntryState::Ready) { function((*it)->value); }
+		}
+	}
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline U64 ConcurrentHashmap<Key, Value, ShardBits>::Size() const { return size; }
+
+template<class Key, class Value, U64 ShardBits>
+inline bool ConcurrentHashmap<Key, Value, ShardBits>::Empty() const { return size == 0; }
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::Shard& ConcurrentHashmap<Key, Value, ShardBits>::GetShard(U64 hash)
+{
+	//The shard maps index with the low bits, the top bits pick the shard so the two don't correlate
+	if constexpr (ShardBits == 0) { return shards[0]; }
+	else { return shards[hash >> (64 - ShardBits)]; }
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline ConcurrentHashmap<Key, Value, ShardBits>::Entry* ConcurrentHashmap<Key, Value, ShardBits>::CreateEntry()
+{
+	Entry* entry = nullptr;
+	Memory::AllocateZeroed(&entry, tag);
+	entry->state.store(EntryState::Creating, std::memory_order_relaxed);
+	entry->references.store(1, std::memory_order_relaxed);
+
+	return entry;
+}
+
+template<class Key, class Value, U64 ShardBits>
+inline void ConcurrentHashmap<Key, Value, ShardBits>::Release(Entry* entry)
+{
+	if constexpr (IsDestroyable<Value>)
+	{
+		if constexpr (IsPointer<Value>) { entry->value->Destroy(); }
+		else { entry->value.Destroy(); }
+	}
+
+	Memory::Free(&entry);
+}
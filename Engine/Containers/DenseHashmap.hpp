@@ -0,0 +1,436 @@
+#pragma once
+
+#include "Defines.hpp"
+#include "TypeTraits.hpp"
+
+#include "Hashmap.hpp"
+
+/// <summary>
+/// Hashmap that keeps its keys and values packed in arrays, a separate index table of control bytes finds the position of a key,
+/// iterating only visits live values and removing moves the last entry into the hole, so positions change on removal
+/// </summary>
+template<class Key, class Value>
+struct DenseHashmap
+{
+	DenseHashmap();
+	DenseHashmap(U32 capacity);
+	DenseHashmap(MemoryTag tag, U32 capacity);
+	DenseHashmap(DenseHashmap&& other) noexcept;
+
+	DenseHashmap& operator=(DenseHashmap&& other) noexcept;
+
+	DenseHashmap(const DenseHashmap&) = delete;
+	DenseHashmap& operator=(const DenseHashmap&) = delete;
+
+	~DenseHashmap();
+	void Destroy();
+	void Clear();
+
+	bool Insert(const Key& key, const Value& value);
+	bool Insert(const Key& key, Value&& value) noexcept;
+
+	/// <summary>
+	/// Gets the value of key, default constructing it if it doesn't exist
+	/// </summary>
+	Value* Request(const Key& key);
+	bool Remove(const Key& key);
+
+	Value* Get(const Key& key);
+	const Value* Get(const Key& key) const;
+	bool Contains(const Key& key) const;
+
+	/// <summary>
+	/// Gets the position of key's value in the packed arrays, U32_MAX if it doesn't exist
+	/// </summary>
+	U32 IndexOf(const Key& key) const;
+	const Key& KeyAt(U32 index) const;
+
+	void Reserve(U32 capacity);
+
+	U32 Size() const;
+	U32 Capacity() const;
+	bool Empty() const;
+
+	Value* Data();
+	const Value* Data() const;
+	const Key* Keys() const;
+
+	Value* begin();
+	Value* end();
+	const Value* begin() const;
+	const Value* end() const;
+
+private:
+	static U8 Fragment(U64 hash) { return (U8)(hash & 0x7F); }
+	static U32 Threshold(U32 capacity) { return capacity - capacity / 8; }
+
+	U32 Find(const Key& key, U64 hash) const;
+	U32 FindIndex(U64 hash, U32 index) const;
+	U32 Claim(U64 hash);
+	U32 Append(const Key& key, U64 hash);
+	void Rehash(U32 tableCapacity);
+
+	U32 size = 0;
+	U32 capacity = 0;
+	U32 tableCapacity = 0;
+	U32 groupMask = 0;
+	U32 deleted = 0;
+
+	Key* keys = nullptr;
+	Value* values = nullptr;
+	U64* hashes = nullptr;		//Hash of each key, kept to rehash and to find the slot of a moved entry without hashing again
+	U8* control = nullptr;		//Index table, one byte per slot, Empty, Deleted or the key's hash fragment
+	U32* indices = nullptr;		//Position in the packed arrays of each slot's entry
+	MemoryTag tag = MemoryTag::Current;
+};
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>::DenseHashmap() {}
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>::DenseHashmap(U32 cap) { Reserve(cap); }
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>::DenseHashmap(MemoryTag tag, U32 cap) : tag(tag) { Reserve(cap); }
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>::DenseHashmap(DenseHashmap&& other) noexcept : size(other.size), capacity(other.capacity),
+	tableCapacity(other.tableCapacity), groupMask(other.groupMask), deleted(other.deleted), keys(other.keys), values(other.values),
+	hashes(other.hashes), control(other.control), indices(other.indices), tag(other.tag)
+{
+	other.size = 0;
+	other.capacity = 0;
+	other.tableCapacity = 0;
+	other.groupMask = 0;
+	other.deleted = 0;
+	other.keys = nullptr;
+	other.values = nullptr;
+	other.hashes = nullptr;
+	other.control = nullptr;
+	other.indices = nullptr;
+}
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>& DenseHashmap<Key, Value>::operator=(DenseHashmap&& other) noexcept
+{
+	Destroy();
+
+	size = other.size;
+	capacity = other.capacity;
+	tableCapacity = other.tableCapacity;
+	groupMask = other.groupMask;
+	deleted = other.deleted;
+	keys = other.keys;
+	values = other.values;
+	hashes = other.hashes;
+	control = other.control;
+	indices = other.indices;
+	tag = other.tag;
+
+	other.size = 0;
+	other.capacity = 0;
+	other.tableCapacity = 0;
+	other.groupMask = 0;
+	other.deleted = 0;
+	other.keys = nullptr;
+	other.values = nullptr;
+	other.hashes = nullptr;
+	other.control = nullptr;
+	other.indices = nullptr;
+
+	return *this;
+}
+
+template<class Key, class Value>
+inline DenseHashmap<Key, Value>::~DenseHashmap() { Destroy(); }
+
+template<class Key, class Value>
+inline void DenseHashmap<Key, Value>::Destroy()
+{
+	Clear();
+
+	if (keys) { Memory::Free(&keys); }
+	if (values) { Memory::Free(&values); }
+	if (hashes) { Memory::Free(&hashes); }
+	if (control) { Memory::Free(&control); }
+	if (indices) { Memory::Free(&indices); }
+
+	capacity = 0;
+	tableCapacity = 0;
+	groupMask = 0;
+}
+
+template<class Key, class Value>
+inline void DenseHashmap<Key, Value>::Clear()
+{
+	if constexpr (IsDestructible<Key>)
+	{
+		for (Key* it = keys, *end = keys + size; it != end; ++it) { it->~Key(); }
+	}
+	if constexpr (IsDestructible<Value>)
+	{
+		for (Value* it = values, *end = values + size; it != end; ++it) { it->~Value(); }
+	}
+
+	if (control) { memset(control, HashGroup::Empty, tableCapacity); }
+
+	size = 0;
+	deleted = 0;
+}
+
+template<class Key, class Value>
+inline bool DenseHashmap<Key, Value>::Insert(const Key& key, const Value& value)
+{
+	U64 hash = Hash::Any(key);
+	if (Find(key, hash) != U32_MAX) { return false; }
+
+	U32 index = Append(key, hash);
+	Construct<Value>(values + index, value);
+	return true;
+}
+
+template<class Key, class Value>
+inline bool DenseHashmap<Key, Value>::Insert(const Key& key, Value&& value) noexcept
+{
+	U64 hash = Hash::Any(key);
+	if (Find(key, hash) != U32_MAX) { return false; }
+
+	U32 index = Append(key, hash);
+	Construct<Value>(values + index, Move(value));
+	return true;
+}
+
+template<class Key, class Value>
+inline Value* DenseHashmap<Key, Value>::Request(const Key& key)
+{
+	U64 hash = Hash::Any(key);
+	U32 slot = Find(key, hash);
+	if (slot != U32_MAX) { return values + indices[slot]; }
+
+	U32 index = Append(key, hash);
+	Value* value = values + index;
+	Construct<Value>(value);
+	return value;
+}
+
+template<class Key, class Value>
+inline bool DenseHashmap<Key, Value>::Remove(const Key& key)
+{
+	U64 hash = Hash::Any(key);
+	U32 slot = Find(key, hash);
+	if (slot == U32_MAX) { return false; }
+
+	U32 index = indices[slot];
+	U32 last = --size;
+
+	//Probes already stop at a group with an empty slot, so only a full group needs a tombstone to keep them going
+	U32 base = slot & ~(U32)(HashGroup::Width - 1);
+	if (HashGroup{ control + base }.MatchEmpty()) { control[slot] = HashGroup::Empty; }
+	else
+	{
+		control[slot] = HashGroup::Deleted;
+		++deleted;
+	}
+
+	if constexpr (IsDestructible<Key>) { keys[index].~Key(); }
+	if constexpr (IsDestructible<Value>) { values[index].~Value(); }
+
+	//Keep the entries packed by moving the last one into the hole
+	if (index != last)
+	{
+		indices[FindIndex(hashes[last], last)] = index;
+
+		memcpy(keys + index, keys + last, sizeof(Key));
+		memcpy(values + index, values + last, sizeof(Value));
+		hashes[index] = hashes[last];
+	}
+
+	return true;
+}
+
+template<class Key, class Value>
+inline Value* DenseHashmap<Key, Value>::Get(const Key& key)
+{
+	U32 slot = Find(key, Hash::Any(key));
+	if (slot == U32_MAX) { return nullptr; }
+
+	return values + indices[slot];
+}
+
+template<class Key, class Value>
+inline const Value* DenseHashmap<Key, Value>::Get(const Key& key) const
+{
+	U32 slot = Find(key, Hash::Any(key));
+	if (slot == U32_MAX) { return nullptr; }
+
+	return values + indices[slot];
+}
+
+template<class Key, class Value>
+inline bool DenseHashmap<Key, Value>::Contains(const Key& key) const
+{
+	return Find(key, Hash::Any(key)) != U32_MAX;
+}
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::IndexOf(const Key& key) const
+{
+	U32 slot = Find(key, Hash::Any(key));
+	if (slot == U32_MAX) { return U32_MAX; }
+
+	return indices[slot];
+}
+
+template<class Key, class Value>
+inline const Key& DenseHashmap<Key, Value>::KeyAt(U32 index) const { return keys[index]; }
+
+template<class Key, class Value>
+inline void DenseHashmap<Key, Value>::Reserve(U32 cap)
+{
+	if (cap <= capacity) { return; }
+
+	U64 keyCapacity = Memory::Reallocate(&keys, cap, size, tag);
+	U64 valueCapacity = Memory::Reallocate(&values, cap, size, tag);
+	U64 hashCapacity = Memory::Reallocate(&hashes, cap, size, tag);
+
+	//The allocations round up separately, only use what all three fit
+	U64 fit = keyCapacity < valueCapacity ? keyCapacity : valueCapacity;
+	if (hashCapacity < fit) { fit = hashCapacity; }
+	capacity = fit < U32_MAX ? (U32)fit : U32_MAX - 1;
+
+	//Size the index table so a full map still stays under 7/8 load
+	U32 table = BitCeiling(capacity + capacity / 7 + 1);
+	if (table < HashGroup::Width) { table = HashGroup::Width; }
+	if (table > tableCapacity) { Rehash(table); }
+}
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::Size() const { return size; }
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::Capacity() const { return capacity; }
+
+template<class Key, class Value>
+inline bool DenseHashmap<Key, Value>::Empty() const { return size == 0; }
+
+template<class Key, class Value>
+inline Value* DenseHashmap<Key, Value>::Data() { return values; }
+
+template<class Key, class Value>
+inline const Value* DenseHashmap<Key, Value>::Data() const { return values; }
+
+template<class Key, class Value>
+inline const Key* DenseHashmap<Key, Value>::Keys() const { return keys; }
+
+template<class Key, class Value>
+inline Value* DenseHashmap<Key, Value>::begin() { return values; }
+
+template<class Key, class Value>
+inline Value* DenseHashmap<Key, Value>::end() { return values + size; }
+
+template<class Key, class Value>
+inline const Value* DenseHashmap<Key, Value>::begin() const { return values; }
+
+template<class Key, class Value>
+inline const Value* DenseHashmap<Key, Value>::end() const { return values + size; }
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::Find(const Key& key, U64 hash) const
+{
+	if (size == 0) { return U32_MAX; }
+
+	U8 fragment = Fragment(hash);
+	U32 group = (U32)(hash >> 7) & groupMask;
+
+	for (U32 i = 0; i <= groupMask; ++i)
+	{
+		U32 base = group * HashGroup::Width;
+		HashGroup controls{ control + base };
+
+		for (U32 match = controls.Match(fragment); match; match &= match - 1)
+		{
+			U32 slot = base + std::countr_zero(match);
+			if (keys[indices[slot]] == key) { return slot; }
+		}
+
+		if (controls.MatchEmpty()) { return U32_MAX; }
+
+		group = (group + i + 1) & groupMask;
+	}
+
+	return U32_MAX;
+}
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::FindIndex(U64 hash, U32 index) const
+{
+	U8 fragment = Fragment(hash);
+	U32 group = (U32)(hash >> 7) & groupMask;
+
+	//The entry is known to be in the table, compare positions instead of keys
+	for (U32 i = 0; ; ++i)
+	{
+		U32 base = group * HashGroup::Width;
+
+		for (U32 match = HashGroup{ control + base }.Match(fragment); match; match &= match - 1)
+		{
+			U32 slot = base + std::countr_zero(match);
+			if (indices[slot] == index) { return slot; }
+		}
+
+		group = (group + i + 1) & groupMask;
+	}
+}
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::Claim(U64 hash)
+{
+	U32 group = (U32)(hash >> 7) & groupMask;
+
+	for (U32 i = 0; ; ++i)
+	{
+		U32 base = group * HashGroup::Width;
+		U32 free = HashGroup{ control + base }.MatchFree();
+
+		if (free)
+		{
+			U32 slot = base + std::countr_zero(free);
+			deleted -= control[slot] == HashGroup::Deleted;
+			control[slot] = Fragment(hash);
+			return slot;
+		}
+
+		group = (group + i + 1) & groupMask;
+	}
+}
+
+template<class Key, class Value>
+inline U32 DenseHashmap<Key, Value>::Append(const Key& key, U64 hash)
+{
+	if (size == capacity) { Reserve(capacity ? capacity * 2 : 16); }
+	else if (size + deleted >= Threshold(tableCapacity)) { Rehash(tableCapacity); }
+
+	U32 index = size++;
+	indices[Claim(hash)] = index;
+	hashes[index] = hash;
+	Construct<Key>(keys + index, key);
+
+	return index;
+}
+
+template<class Key, class Value>
+inline void DenseHashmap<Key, Value>::Rehash(U32 table)
+{
+	if (control) { Memory::Free(&control); }
+	if (indices) { Memory::Free(&indices); }
+
+	tableCapacity = table;
+	groupMask = table / HashGroup::Width - 1;
+	deleted = 0;
+
+	Memory::Allocate(&control, tableCapacity, tag);
+	Memory::Allocate(&indices, tableCapacity, tag);
+	memset(control, HashGroup::Empty, tableCapacity);
+
+	for (U32 i = 0; i < size; ++i) { indices[Claim(hashes[i])] = i; }
+}
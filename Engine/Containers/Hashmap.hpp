@@ -6,12 +6,116 @@
 #include "Platform/Memory.hpp"
 #include "Math/Hash.hpp"
 
+#if defined NH_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined NH_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/// <summary>
+/// Sixteen control bytes of a Hashmap, compared at once to find the slots worth looking at
+/// </summary>
+struct HashGroup
+{
+	static constexpr inline U64 Width = 16;
+	static constexpr inline U8 Empty = 0x80;
+	static constexpr inline U8 Deleted = 0xFE;
+
+	HashGroup(const U8* control);
+
+	static bool Full(U8 control) { return control < 0x80; }
+
+	/// <summary>
+	/// Gets a mask of the slots holding fragment, bit n is slot n of the group
+	/// </summary>
+	U32 Match(U8 fragment) const;
+	U32 MatchEmpty() const;
+
+	/// <summary>
+	/// Gets a mask of the slots that are empty or deleted
+	/// </summary>
+	U32 MatchFree() const;
+
+private:
+#if defined NH_SIMD_SSE2
+	__m128i bytes;
+#elif defined NH_SIMD_NEON
+	uint8x16_t bytes;
+
+	static U32 Mask(uint8x16_t matches);
+#else
+	U8 bytes[Width];
+#endif
+};
+
+#if defined NH_SIMD_SSE2
+inline HashGroup::HashGroup(const U8* control) : bytes(_mm_loadu_si128((const __m128i*)control)) {}
+
+inline U32 HashGroup::Match(U8 fragment) const { return (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((I8)fragment))); }
+
+inline U32 HashGroup::MatchEmpty() const { return (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((I8)Empty))); }
+
+inline U32 HashGroup::MatchFree() const { return (U32)_mm_movemask_epi8(bytes); }
+#elif defined NH_SIMD_NEON
+inline HashGroup::HashGroup(const U8* control) : bytes(vld1q_u8(control)) {}
+
+inline U32 HashGroup::Mask(uint8x16_t matches)
+{
+	//NEON has no movemask, weight each lane by its bit and add the halves
+	static const U8 weights[Width] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+
+	uint8x16_t bits = vandq_u8(matches, vld1q_u8(weights));
+	return (U32)vaddv_u8(vget_low_u8(bits)) | ((U32)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+inline U32 HashGroup::Match(U8 fragment) const { return Mask(vceqq_u8(bytes, vdupq_n_u8(fragment))); }
+
+inline U32 HashGroup::MatchEmpty() const { return Mask(vceqq_u8(bytes, vdupq_n_u8(Empty))); }
+
+inline U32 HashGroup::MatchFree() const { return Mask(vcltzq_s8(vreinterpretq_s8_u8(bytes))); }
+#else
+inline HashGroup::HashGroup(const U8* control) { memcpy(bytes, control, Width); }
+
+inline U32 HashGroup::Match(U8 fragment) const
+{
+	U32 mask = 0;
+	for (U32 i = 0; i < Width; ++i) { mask |= (U32)(bytes[i] == fragment) << i; }
+	return mask;
+}
+
+inline U32 HashGroup::MatchEmpty() const { return Match(Empty); }
+
+inline U32 HashGroup::MatchFree() const
+{
+	U32 mask = 0;
+	for (U32 i = 0; i < Width; ++i) { mask |= (U32)!Full(bytes[i]) << i; }
+	return mask;
+}
+#endif
+
+/// <summary>
+/// Occupancy of a Hashmap, probe lengths are the number of groups stepped past a key's home group
+/// </summary>
+struct HashmapStats
+{
+	U64 size;
+	U64 capacity;
+	U64 deleted;
+	U64 maxProbe;
+	F64 averageProbe;
+};
+
+/// <summary>
+/// Open addressing hashmap, each cell has a control byte in a separate array holding 7 bits of its key's hash,
+/// lookups compare a whole group of control bytes at once and only touch the cells whose fragment matched.
+/// The map rehashes into twice the cells once 7/8 of them are taken, unless it was created fixed, in which case cells never move
+/// so handles and value pointers stay valid, and inserting fails when it's full
+/// </summary>
 template<class Key, class Value>
 struct Hashmap
 {
 	struct Cell
 	{
-		bool filled;
 		Key key;
 		Value value;
 	};
@@ -19,7 +123,7 @@ struct Hashmap
 	struct Iterator
 	{
 	public:
-		Iterator(Cell* cell);
+		Iterator(Cell* cell, U8* control);
 		Iterator(const Iterator& other);
 		Iterator(Iterator&& other);
 
@@ -44,10 +148,13 @@ struct Hashmap
 
 	private:
 		Cell* cell;
+		U8* control;
 	};
 
 	Hashmap();
 	Hashmap(U64 capacity);
+	Hashmap(MemoryTag tag, U64 capacity);
+	Hashmap(U64 capacity, bool fixed);
 	Hashmap(Hashmap&& other) noexcept;
 	Hashmap(const Hashmap&);
 
@@ -64,7 +171,16 @@ struct Hashmap
 	bool Remove(const Key& key);
 
 	Value* Get(const Key& key) const;
+
+	/// <summary>
+	/// Get with a precomputed hash, hash must be Hash::Any(key)
+	/// </summary>
+	Value* GetWithHash(const Key& key, U64 hash) const;
 	Value* Request(const Key& key);
+
+	/// <summary>
+	/// Request with a precomputed hash, hash must be Hash::Any(key), rehashing recomputes it
+	/// </summary>
 	Value* RequestWithHash(const Key& key, U64 hash);
 	Value* Request(const Key& key, U64& handle);
 	U64 GetHandle(const Key& key) const;
@@ -82,16 +198,34 @@ struct Hashmap
 	U64 Capacity() const;
 	bool Empty() const;
 
-	Iterator begin() { return { cells }; }
-	const Iterator begin() const { return { cells }; }
-	Iterator end() { return { cells + capacity }; }
-	const Iterator end() const { return { cells + capacity }; }
+	/// <summary>
+	/// Walks every cell to measure probe lengths, meant for tuning rather than every frame
+	/// </summary>
+	HashmapStats Statistics() const;
+
+	Iterator begin() { return { cells, control }; }
+	const Iterator begin() const { return { cells, control }; }
+	Iterator end() { return { cells + capacity, control + capacity }; }
+	const Iterator end() const { return { cells + capacity, control + capacity }; }
 
 private:
+	static U8 Fragment(U64 hash) { return (U8)(hash & 0x7F); }
+	static U64 Threshold(U64 capacity) { return capacity - capacity / 8; }
+
+	void Allocate(U64 capacity);
+	void Rehash(U64 capacity);
+	U64 Find(const Key& key, U64 hash) const;
+	U64 Prepare(const Key& key, U64 hash, bool& found);
+	void Erase(U64 index);
+
 	U64 size = 0;
 	U64 capacity = 0;
-	U64 capMinusOne = 0;
+	U64 groupMask = 0;
+	U64 deleted = 0;
+	bool fixed = false;						//Cells never move, the map stops inserting when full instead of rehashing
 	Cell* cells = nullptr;
+	U8* control = nullptr;					//One byte per cell, Empty, Deleted or the cell's hash fragment
+	MemoryTag tag = MemoryTag::Current;	//Who the cells are charged to
 };
 
 template<class Key, class Value>
@@ -100,37 +234,65 @@ inline Hashmap<Key, Value>::Hashmap() {}
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Hashmap(U64 cap)
 {
-	capacity = BitCeiling(cap);
-	Memory::Allocate(&cells, capacity);
-	capMinusOne = capacity - 1;
+	Allocate(cap);
+}
+
+template<class Key, class Value>
+inline Hashmap<Key, Value>::Hashmap(MemoryTag tag, U64 cap) : tag(tag)
+{
+	Allocate(cap);
 }
 
 template<class Key, class Value>
-inline Hashmap<Key, Value>::Hashmap(const Hashmap& other) : size(other.size), capacity(other.capacity), capMinusOne(other.capMinusOne)
+inline Hashmap<Key, Value>::Hashmap(U64 cap, bool fixed) : fixed(fixed)
 {
-	Memory::Allocate(&cells, capacity);
-	CopyData(cells, other.cells, capacity);
+	Allocate(cap);
+}
+
+template<class Key, class Value>
+inline Hashmap<Key, Value>::Hashmap(const Hashmap& other) : size(other.size), capacity(other.capacity), groupMask(other.groupMask),
+	deleted(other.deleted), fixed(other.fixed), tag(other.tag)
+{
+	if (capacity)
+	{
+		Memory::Allocate(&cells, capacity, tag);
+		Memory::Allocate(&control, capacity, tag);
+		CopyData(cells, other.cells, capacity);
+		CopyData(control, other.control, capacity);
+	}
 }
 
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Hashmap(Hashmap&& other) noexcept :
-	cells(other.cells), size(other.size), capacity(other.capacity), capMinusOne(other.capMinusOne)
+	size(other.size), capacity(other.capacity), groupMask(other.groupMask), deleted(other.deleted), fixed(other.fixed),
+	cells(other.cells), control(other.control), tag(other.tag)
 {
 	other.cells = nullptr;
+	other.control = nullptr;
 	other.size = 0;
 	other.capacity = 0;
-	other.capMinusOne = 0;
+	other.groupMask = 0;
+	other.deleted = 0;
 }
 
 template<class Key, class Value>
 inline Hashmap<Key, Value>& Hashmap<Key, Value>::operator=(const Hashmap& other)
 {
+	Destroy();
+
 	size = other.size;
 	capacity = other.capacity;
-	capMinusOne = other.capMinusOne;
+	groupMask = other.groupMask;
+	deleted = other.deleted;
+	fixed = other.fixed;
 
-	Memory::Allocate(&cells, capacity);
-	CopyData(cells, other.cells, capacity);
+	if (capacity)
+	{
+		Memory::Allocate(&cells, capacity, tag);
+		Memory::Allocate(&control, capacity, tag);
+		CopyData(cells, other.cells, capacity);
+		CopyData(control, other.control, capacity);
+	}
 
 	return *this;
 }
@@ -139,14 +301,20 @@ template<class Key, class Value>
 inline Hashmap<Key, Value>& Hashmap<Key, Value>::operator=(Hashmap&& other) noexcept
 {
 	cells = other.cells;
+	control = other.control;
 	size = other.size;
 	capacity = other.capacity;
-	capMinusOne = other.capMinusOne;
+	groupMask = other.groupMask;
+	deleted = other.deleted;
+	fixed = other.fixed;
+	tag = other.tag;
 
 	other.cells = nullptr;
+	other.control = nullptr;
 	other.size = 0;
 	other.capacity = 0;
-	other.capMinusOne = 0;
+	other.groupMask = 0;
+	other.deleted = 0;
 
 	return *this;
 }
@@ -167,7 +335,7 @@ inline void Hashmap<Key, Value>::Destroy()
 			Cell* cell = cells;
 			for (U64 i = 0; i < capacity; ++i, ++cell)
 			{
-				if (cell->filled)
+				if (HashGroup::Full(control[i]))
 				{
 					//TODO: Key or Value could be allocated
 					if constexpr (IsDestroyable<Key>)
@@ -185,199 +353,298 @@ inline void Hashmap<Key, Value>::Destroy()
 		}
 
 		Memory::Free(&cells);
+		Memory::Free(&control);
 		size = 0;
 		capacity = 0;
-		capMinusOne = 0;
+		groupMask = 0;
+		deleted = 0;
 	}
 }
 
 template<class Key, class Value>
-inline bool Hashmap<Key, Value>::Insert(const Key& key, const Value& value)
+inline void Hashmap<Key, Value>::Allocate(U64 cap)
 {
-	if (size == capacity) { return false; }
+	//Capacity is a whole number of groups so a group never wraps around the end of the control bytes
+	capacity = BitCeiling(cap < HashGroup::Width ? HashGroup::Width : cap);
+	groupMask = capacity / HashGroup::Width - 1;
+
+	//Cells start zeroed, Request hands out new values as-is
+	Memory::AllocateZeroed(&cells, capacity, tag);
+	Memory::Allocate(&control, capacity, tag);
+	memset(control, HashGroup::Empty, capacity);
+}
 
-	U64 hash = Hash::Any(key);
+template<class Key, class Value>
+inline void Hashmap<Key, Value>::Rehash(U64 cap)
+{
+	Cell* oldCells = cells;
+	U8* oldControl = control;
+	U64 oldCapacity = capacity;
 
-	U32 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
+	Allocate(cap);
+	deleted = 0;
 
-	while (cell->filled) { if (cell->key == key) { return false; } ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	//Every key is known to be unique, so each one only needs the first empty cell along its probe
+	for (U64 i = 0; i < oldCapacity; ++i)
+	{
+		if (!HashGroup::Full(oldControl[i])) { continue; }
 
-	++size;
-	cell->filled = true;
-	cell->value = value;
-	cell->key = key;
+		U64 hash = Hash::Any(oldCells[i].key);
+		U64 group = (hash >> 7) & groupMask;
 
-	return true;
+		for (U64 step = 1; ; ++step)
+		{
+			U64 base = group * HashGroup::Width;
+			U32 empty = HashGroup{ control + base }.MatchEmpty();
+
+			if (empty)
+			{
+				U64 index = base + std::countr_zero(empty);
+				control[index] = Fragment(hash);
+				memcpy(cells + index, oldCells + i, sizeof(Cell));
+				break;
+			}
+
+			group = (group + step) & groupMask;
+		}
+	}
+
+	Memory::Free(&oldCells);
+	Memory::Free(&oldControl);
 }
 
 template<class Key, class Value>
-inline bool Hashmap<Key, Value>::Insert(const Key& key, Value&& value) noexcept
+inline U64 Hashmap<Key, Value>::Find(const Key& key, U64 hash) const
 {
-	if (size == capacity) { return false; }
+	if (size == 0) { return U64_MAX; }
+
+	U8 fragment = Fragment(hash);
+	U64 group = (hash >> 7) & groupMask;
 
-	U64 hash = Hash::Any(key);
+	//Triangular steps over a power of two group count visit every group once
+	for (U64 i = 0; i <= groupMask; ++i)
+	{
+		U64 base = group * HashGroup::Width;
+		HashGroup controls{ control + base };
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
+		for (U32 match = controls.Match(fragment); match; match &= match - 1)
+		{
+			U64 index = base + std::countr_zero(match);
+			if (cells[index].key == key) { return index; }
+		}
 
-	while (cell->filled) { if (cell->key == key) { return false; } ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+		//The key would have been placed here if it existed
+		if (controls.MatchEmpty()) { return U64_MAX; }
 
-	++size;
-	cell->filled = true;
-	cell->value = Move(value);
-	cell->key = key;
+		group = (group + i + 1) & groupMask;
+	}
 
-	return true;
+	return U64_MAX;
 }
 
 template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::GetInsert(const Key& key, const Value& value)
+inline U64 Hashmap<Key, Value>::Prepare(const Key& key, U64 hash, bool& found)
 {
-	U64 hash = Hash::Any(key);
+	found = false;
+	if (capacity == 0)
+	{
+		if (fixed) { return U64_MAX; }
+		Allocate(HashGroup::Width);
+	}
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->filled && cell->key != key) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	U8 fragment = Fragment(hash);
+	U64 group = (hash >> 7) & groupMask;
+	U64 slot = U64_MAX;
 
-	if (cell->filled) { return &cell->value; }
+	for (U64 i = 0; i <= groupMask; ++i)
+	{
+		U64 base = group * HashGroup::Width;
+		HashGroup controls{ control + base };
 
-	++size;
+		for (U32 match = controls.Match(fragment); match; match &= match - 1)
+		{
+			U64 index = base + std::countr_zero(match);
+			if (cells[index].key == key) { found = true; return index; }
+		}
 
-	cell->filled = true;
-	cell->key = key;
-	cell->value = value;
-	return &cell->value;
-}
+		//Keep looking for the key past deleted cells, but remember the first free one
+		if (slot == U64_MAX)
+		{
+			U32 free = controls.MatchFree();
+			if (free) { slot = base + std::countr_zero(free); }
+		}
 
-template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::GetInsert(const Key& key, Value&& value) noexcept
-{
-	U64 hash = Hash::Any(key);
+		if (controls.MatchEmpty()) { break; }
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->filled && cell->key != key) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+		group = (group + i + 1) & groupMask;
+	}
 
-	if (cell->filled) { return &cell->value; }
+	if (slot == U64_MAX) { return U64_MAX; }
 
+	//Tombstones count towards the load too, they lengthen probes just the same
+	if (!fixed && control[slot] == HashGroup::Empty && size + deleted >= Threshold(capacity))
+	{
+		//Double when mostly live, otherwise rehashing at the same size is enough to clear the tombstones
+		Rehash(size >= Threshold(capacity) / 2 ? capacity * 2 : capacity);
+		return Prepare(key, hash, found);
+	}
+
+	deleted -= control[slot] == HashGroup::Deleted;
+	control[slot] = fragment;
 	++size;
 
-	cell->filled = true;
-	cell->key = key;
-	cell->value = Move(value);
-	return &cell->value;
+	return slot;
 }
 
 template<class Key, class Value>
-inline bool Hashmap<Key, Value>::Remove(const Key& key)
+inline void Hashmap<Key, Value>::Erase(U64 index)
 {
-	if (size == 0) { return false; }
-
-	U64 hash = Hash::Any(key);
+	--size;
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->filled && cell->key != key) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	Cell& cell = cells[index];
 
-	if (cell->filled)
+	if constexpr (IsDestroyable<Key>)
 	{
-		--size;
-		if constexpr (IsDestroyable<Key>)
-		{
-			if constexpr (IsPointer<Value>) { cell->key->Destroy(); }
-			else { cell->key.Destroy(); }
-		}
-		if constexpr (IsDestroyable<Value>)
-		{
-			if constexpr (IsPointer<Value>) { cell->value->Destroy(); }
-			else { cell->value.Destroy(); }
-		}
-		memset(cell, 0, sizeof(Cell));
-
-		return true;
+		if constexpr (IsPointer<Key>) { cell.key->Destroy(); }
+		else { cell.key.Destroy(); }
 	}
+	if constexpr (IsDestroyable<Value>)
+	{
+		if constexpr (IsPointer<Value>) { cell.value->Destroy(); }
+		else { cell.value.Destroy(); }
+	}
+	memset(&cell, 0, sizeof(Cell));
 
-	return false;
+	//Probes already stop at a group with an empty cell, so only a full group needs a tombstone to keep them going
+	U64 base = index & ~(HashGroup::Width - 1);
+	if (HashGroup{ control + base }.MatchEmpty()) { control[index] = HashGroup::Empty; }
+	else
+	{
+		control[index] = HashGroup::Deleted;
+		++deleted;
+	}
 }
 
 template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::Get(const Key& key) const
+inline bool Hashmap<Key, Value>::Insert(const Key& key, const Value& value)
 {
-	if (size == 0) { return nullptr; }
+	bool found;
+	U64 index = Prepare(key, Hash::Any(key), found);
+	if (found || index == U64_MAX) { return false; }
 
-	U64 hash = Hash::Any(key);
+	Cell& cell = cells[index];
+	cell.value = value;
+	cell.key = key;
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->filled && cell->key != key) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	return true;
+}
 
-	if (cell->filled) { return &cell->value; }
-	return nullptr;
+template<class Key, class Value>
+inline bool Hashmap<Key, Value>::Insert(const Key& key, Value&& value) noexcept
+{
+	bool found;
+	U64 index = Prepare(key, Hash::Any(key), found);
+	if (found || index == U64_MAX) { return false; }
+
+	Cell& cell = cells[index];
+	cell.value = Move(value);
+	cell.key = key;
+
+	return true;
 }
 
 template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::Request(const Key& key)
+inline Value* Hashmap<Key, Value>::GetInsert(const Key& key, const Value& value)
 {
-	U64 hash = Hash::Any(key);
+	bool found;
+	U64 index = Prepare(key, Hash::Any(key), found);
+	if (index == U64_MAX) { return nullptr; }
 
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
+	Cell& cell = cells[index];
+	if (found) { return &cell.value; }
 
-	while (cell->filled) { if (cell->key == key) { return &cell->value; } ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	cell.key = key;
+	cell.value = value;
+	return &cell.value;
+}
 
-	++size;
+template<class Key, class Value>
+inline Value* Hashmap<Key, Value>::GetInsert(const Key& key, Value&& value) noexcept
+{
+	bool found;
+	U64 index = Prepare(key, Hash::Any(key), found);
+	if (index == U64_MAX) { return nullptr; }
+
+	Cell& cell = cells[index];
+	if (found) { return &cell.value; }
 
-	cell->filled = true;
-	cell->key = key;
-	return &cell->value;
+	cell.key = key;
+	cell.value = Move(value);
+	return &cell.value;
 }
 
 template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::RequestWithHash(const Key& key, U64 hash)
+inline bool Hashmap<Key, Value>::Remove(const Key& key)
 {
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
+	U64 index = Find(key, Hash::Any(key));
+	if (index == U64_MAX) { return false; }
 
-	while (cell->filled) { if (cell->key == key) { return &cell->value; } ++i; cell = cells + ((hash + i * i) & capMinusOne); }
+	Erase(index);
+	return true;
+}
 
-	++size;
+template<class Key, class Value>
+inline Value* Hashmap<Key, Value>::Get(const Key& key) const
+{
+	U64 index = Find(key, Hash::Any(key));
+	if (index == U64_MAX) { return nullptr; }
 
-	cell->filled = true;
-	cell->key = key;
-	return &cell->value;
+	return &cells[index].value;
 }
 
 template<class Key, class Value>
-inline Value* Hashmap<Key, Value>::Request(const Key& key, U64& handle)
+inline Value* Hashmap<Key, Value>::GetWithHash(const Key& key, U64 hash) const
 {
-	U64 hash = Hash::Any(key);
+	U64 index = Find(key, hash);
+	if (index == U64_MAX) { return nullptr; }
 
-	U64 i = 0;
-	handle = hash & capMinusOne;
-	Cell* cell = cells + handle;
+	return &cells[index].value;
+}
 
-	while (cell->filled) { if (cell->key == key) { return &cell->value; } ++i; cell = cells + (handle = ((hash + i * i) & capMinusOne)); }
+template<class Key, class Value>
+inline Value* Hashmap<Key, Value>::Request(const Key& key)
+{
+	return RequestWithHash(key, Hash::Any(key));
+}
 
-	size += !cell->filled;
+template<class Key, class Value>
+inline Value* Hashmap<Key, Value>::RequestWithHash(const Key& key, U64 hash)
+{
+	bool found;
+	U64 index = Prepare(key, hash, found);
+	if (index == U64_MAX) { return nullptr; }
 
-	cell->filled = true;
-	cell->key = key;
-	return &cell->value;
+	Cell& cell = cells[index];
+	if (!found) { cell.key = key; }
+	return &cell.value;
 }
 
 template<class Key, class Value>
-inline U64 Hashmap<Key, Value>::GetHandle(const Key& key) const
+inline Value* Hashmap<Key, Value>::Request(const Key& key, U64& handle)
 {
-	U64 hash = Hash::Any(key);
+	bool found;
+	handle = Prepare(key, Hash::Any(key), found);
+	if (handle == U64_MAX) { return nullptr; }
 
-	U64 i = 0;
-	U64 handle = hash & capMinusOne;
-	Cell* cell = cells + handle;
-	while (cell->filled && cell->key != key) { ++i; cell = cells + (handle = ((hash + i * i) & capMinusOne)); }
+	Cell& cell = cells[handle];
+	if (!found) { cell.key = key; }
+	return &cell.value;
+}
 
-	if (cell->filled) { return handle; }
-	else { return U64_MAX; }
+template<class Key, class Value>
+inline U64 Hashmap<Key, Value>::GetHandle(const Key& key) const
+{
+	return Find(key, Hash::Any(key));
 }
 
 template<class Key, class Value>
@@ -389,58 +656,22 @@ inline Value* Hashmap<Key, Value>::Obtain(U64 handle) const
 template<class Key, class Value>
 inline bool Hashmap<Key, Value>::Remove(U64 handle)
 {
-	Cell& cell = cells[handle];
+	if (handle >= capacity || !HashGroup::Full(control[handle])) { return false; }
 
-	if (cell.filled)
-	{
-		--size;
-
-		if constexpr (IsDestroyable<Key>)
-		{
-			if constexpr (IsPointer<Value>) { cell.key->Destroy(); }
-			else { cell.key.Destroy(); }
-		}
-		if constexpr (IsDestroyable<Value>)
-		{
-			if constexpr (IsPointer<Value>) { cell.value->Destroy(); }
-			else { cell.value.Destroy(); }
-		}
-		memset(&cell, 0, sizeof(Cell));
-
-		return true;
-	}
-
-	return false;
+	Erase(handle);
+	return true;
 }
 
 template<class Key, class Value>
 inline Value* Hashmap<Key, Value>::operator[](const Key& key)
 {
-	if (size == 0) { return nullptr; }
-
-	U64 hash = Hash::Any(key);
-
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->key != key && cell->filled) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
-
-	if (cell->filled) { return &cell->value; }
-	else { return nullptr; }
+	return Get(key);
 }
 
 template<class Key, class Value>
 inline const Value* Hashmap<Key, Value>::operator[](const Key& key) const
 {
-	if (size == 0) { return nullptr; }
-
-	U64 hash = Hash::Any(key);
-
-	U64 i = 0;
-	Cell* cell = cells + (hash & capMinusOne);
-	while (cell->key != key && cell->filled) { ++i; cell = cells + ((hash + i * i) & capMinusOne); }
-
-	if (cell->filled) { return &cell->value; }
-	else { return nullptr; }
+	return Get(key);
 }
 
 template<class Key, class Value>
@@ -448,11 +679,8 @@ inline void Hashmap<Key, Value>::Reserve(U64 cap)
 {
 	if (cap <= capacity) { return; }
 
-	capacity = BitFloor(cap);
-	Memory::Reallocate(&cells, cap);
-	capMinusOne = capacity - 1;
-
-	Clear();
+	if (capacity == 0) { Allocate(cap); }
+	else { Rehash(cap); }
 }
 
 template<class Key, class Value>
@@ -461,12 +689,14 @@ inline void Hashmap<Key, Value>::operator()(U64 capacity) { Reserve(capacity); }
 template<class Key, class Value>
 inline void Hashmap<Key, Value>::Clear()
 {
+	if (capacity == 0) { return; }
+
 	if constexpr (IsDestroyable<Key> || IsDestroyable<Value>)
 	{
 		Cell* cell = cells;
 		for (U64 i = 0; i < capacity; ++i, ++cell)
 		{
-			if (cell->filled)
+			if (HashGroup::Full(control[i]))
 			{
 				if constexpr (IsDestroyable<Key>)
 				{
@@ -483,31 +713,63 @@ inline void Hashmap<Key, Value>::Clear()
 	}
 
 	memset(cells, 0, sizeof(Cell) * capacity);
+	memset(control, HashGroup::Empty, capacity);
 	size = 0;
+	deleted = 0;
 }
 
 template<class Key, class Value>
 inline U64 Hashmap<Key, Value>::Size() const { return size; }
 
 template<class Key, class Value>
-inline U64 Hashmap<Key, Value>::Capacity() const { return size; }
+inline U64 Hashmap<Key, Value>::Capacity() const { return capacity; }
 
 template<class Key, class Value>
 inline bool Hashmap<Key, Value>::Empty() const { return size == 0; }
 
+template<class Key, class Value>
+inline HashmapStats Hashmap<Key, Value>::Statistics() const
+{
+	HashmapStats stats{ size, capacity, deleted, 0, 0.0 };
+
+	U64 total = 0;
+	for (U64 i = 0; i < capacity; ++i)
+	{
+		if (!HashGroup::Full(control[i])) { continue; }
+
+		//Replay the probe from the home group until it reaches the cell's group
+		U64 group = (Hash::Any(cells[i].key) >> 7) & groupMask;
+		U64 target = i / HashGroup::Width;
+		U64 probe = 0;
+
+		while (group != target && probe <= groupMask)
+		{
+			++probe;
+			group = (group + probe) & groupMask;
+		}
+
+		total += probe;
+		if (probe > stats.maxProbe) { stats.maxProbe = probe; }
+	}
+
+	if (size) { stats.averageProbe = (F64)total / size; }
+
+	return stats;
+}
+
 /*------ITERATOR------*/
 
 template<class Key, class Value>
-inline Hashmap<Key, Value>::Iterator::Iterator(Cell* cell) : cell{ cell } {}
+inline Hashmap<Key, Value>::Iterator::Iterator(Cell* cell, U8* control) : cell{ cell }, control{ control } {}
 
 template<class Key, class Value>
-inline Hashmap<Key, Value>::Iterator::Iterator(const Iterator& other) : cell{ cell } {}
+inline Hashmap<Key, Value>::Iterator::Iterator(const Iterator& other) : cell{ other.cell }, control{ other.control } {}
 
 template<class Key, class Value>
-inline Hashmap<Key, Value>::Iterator::Iterator(Iterator&& other) : cell{ cell } {}
+inline Hashmap<Key, Value>::Iterator::Iterator(Iterator&& other) : cell{ other.cell }, control{ other.control } {}
 
 template<class Key, class Value>
-inline bool Hashmap<Key, Value>::Iterator::Valid() const { return cell->filled; }
+inline bool Hashmap<Key, Value>::Iterator::Valid() const { return HashGroup::Full(*control); }
 
 template<class Key, class Value>
 inline Value& Hashmap<Key, Value>::Iterator::operator* () { return cell->value; }
@@ -518,16 +780,18 @@ inline Value* Hashmap<Key, Value>::Iterator::operator-> () { return &cell->value
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Iterator Hashmap<Key, Value>::Iterator::operator++()
 {
-	Cell* temp = cell;
+	Iterator temp = *this;
 	++cell;
+	++control;
 
-	return { temp };
+	return temp;
 }
 
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Iterator& Hashmap<Key, Value>::Iterator::operator++(int)
 {
 	++cell;
+	++control;
 
 	return *this;
 }
@@ -535,16 +799,18 @@ inline Hashmap<Key, Value>::Iterator& Hashmap<Key, Value>::Iterator::operator++(
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Iterator Hashmap<Key, Value>::Iterator::operator--()
 {
-	Cell* temp = cell;
+	Iterator temp = *this;
 	--cell;
+	--control;
 
-	return { temp };
+	return temp;
 }
 
 template<class Key, class Value>
 inline Hashmap<Key, Value>::Iterator& Hashmap<Key, Value>::Iterator::operator--(int)
 {
 	--cell;
+	--control;
 
 	return *this;
 }
@@ -568,4 +834,4 @@ template<class Key, class Value>
 inline bool Hashmap<Key, Value>::Iterator::operator<= (const Iterator& other) const { return cell <= other.cell; }
 
 template<class Key, class Value>
-inline bool Hashmap<Key, Value>::Iterator::operator>= (const Iterator& other) const { return cell >= other.cell; }
\ No newline at end of file
+inline bool Hashmap<Key, Value>::Iterator::operator>= (const Iterator& other) const { return cell >= other.cell; }
@@ -0,0 +1,330 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Platform/Memory.hpp"
+
+/// <summary>
+/// Handle to an object in a Pool, the low bits are the slot index and the high bits the slot's generation,
+/// so a handle kept after its object was removed no longer resolves
+/// </summary>
+using PoolHandle = U32;
+
+static constexpr inline PoolHandle InvalidPoolHandle = U32_MAX;
+
+/// <summary>
+/// Stores objects densely for contiguous iteration, each object is reached through a generational handle that stays the same
+/// while the object moves around inside the pool, removing swaps the last object into the hole
+/// </summary>
+template<class Type>
+struct Pool
+{
+	Pool();
+	Pool(U32 capacity);
+	Pool(MemoryTag tag, U32 capacity);
+	Pool(Pool&& other) noexcept;
+
+	Pool& operator=(Pool&& other) noexcept;
+
+	Pool(const Pool&) = delete;
+	Pool& operator=(const Pool&) = delete;
+
+	~Pool();
+	void Destroy();
+	void Clear();
+
+	PoolHandle Insert(const Type& value);
+	PoolHandle Insert(Type&& value) noexcept;
+	template<class... Parameters> PoolHandle Emplace(Parameters&&... parameters) noexcept;
+	bool Remove(PoolHandle handle);
+
+	Type* Get(PoolHandle handle);
+	const Type* Get(PoolHandle handle) const;
+	bool Valid(PoolHandle handle) const;
+
+	/// <summary>
+	/// Gets the handle of the object at index when iterating
+	/// </summary>
+	PoolHandle Handle(U32 index) const;
+
+	void Reserve(U32 capacity);
+
+	U32 Capacity() const;
+	U32 Size() const;
+	bool Empty() const;
+
+	Type* Data();
+	const Type* Data() const;
+
+	Type* begin();
+	Type* end();
+	const Type* begin() const;
+	const Type* end() const;
+
+	static constexpr inline U32 IndexBits = 20;
+	static constexpr inline U32 MaxCapacity = (1u << IndexBits) - 1;	//The last index is left out so no handle equals InvalidPoolHandle
+
+private:
+	static constexpr inline U32 IndexMask = (1u << IndexBits) - 1;
+	static constexpr inline U32 GenerationMask = U32_MAX >> IndexBits;
+
+	struct Slot
+	{
+		U32 index;		//Index into dense while in use, next free slot otherwise
+		U32 generation;
+	};
+
+	PoolHandle Acquire();
+
+	U32 size = 0;
+	U32 capacity = 0;
+	U32 freeSlot = U32_MAX;
+	U32 slotCount = 0;
+
+	Type* dense = nullptr;
+	U32* owners = nullptr;		//Slot of each dense object
+	Slot* slots = nullptr;
+	MemoryTag tag = MemoryTag::Current;
+};
+
+template<class Type>
+inline Pool<Type>::Pool() {}
+
+template<class Type>
+inline Pool<Type>::Pool(U32 cap) { Reserve(cap); }
+
+template<class Type>
+inline Pool<Type>::Pool(MemoryTag tag, U32 cap) : tag(tag) { Reserve(cap); }
+
+template<class Type>
+inline Pool<Type>::Pool(Pool&& other) noexcept : size(other.size), capacity(other.capacity), freeSlot(other.freeSlot), slotCount(other.slotCount),
+	dense(other.dense), owners(other.owners), slots(other.slots), tag(other.tag)
+{
+	other.size = 0;
+	other.capacity = 0;
+	other.freeSlot = U32_MAX;
+	other.slotCount = 0;
+	other.dense = nullptr;
+	other.owners = nullptr;
+	other.slots = nullptr;
+}
+
+template<class Type>
+inline Pool<Type>& Pool<Type>::operator=(Pool&& other) noexcept
+{
+	Destroy();
+
+	size = other.size;
+	capacity = other.capacity;
+	freeSlot = other.freeSlot;
+	slotCount = other.slotCount;
+	dense = other.dense;
+	owners = other.owners;
+	slots = other.slots;
+	tag = other.tag;
+
+	other.size = 0;
+	other.capacity = 0;
+	other.freeSlot = U32_MAX;
+	other.slotCount = 0;
+	other.dense = nullptr;
+	other.owners = nullptr;
+	other.slots = nullptr;
+
+	return *this;
+}
+
+template<class Type>
+inline Pool<Type>::~Pool() { Destroy(); }
+
+template<class Type>
+inline void Pool<Type>::Destroy()
+{
+	Clear();
+
+	if (dense) { Memory::Free(&dense); }
+	if (owners) { Memory::Free(&owners); }
+	if (slots) { Memory::Free(&slots); }
+
+	capacity = 0;
+	freeSlot = U32_MAX;
+	slotCount = 0;
+}
+
+template<class Type>
+inline void Pool<Type>::Clear()
+{
+	if constexpr (IsDestructible<Type>)
+	{
+		for (Type* it = dense, *end = dense + size; it != end; ++it) { it->~Type(); }
+	}
+
+	//Bump every slot in use so their handles go stale, then hand them back
+	for (U32 i = 0; i < size; ++i)
+	{
+		Slot& slot = slots[owners[i]];
+		slot.generation = (slot.generation + 1) & GenerationMask;
+		slot.index = freeSlot;
+		freeSlot = owners[i];
+	}
+
+	size = 0;
+}
+
+template<class Type>
+inline PoolHandle Pool<Type>::Insert(const Type& value)
+{
+	PoolHandle handle = Acquire();
+	if (handle != InvalidPoolHandle) { Construct<Type>(dense + size - 1, value); }
+	return handle;
+}
+
+template<class Type>
+inline PoolHandle Pool<Type>::Insert(Type&& value) noexcept
+{
+	PoolHandle handle = Acquire();
+	if (handle != InvalidPoolHandle) { Construct<Type>(dense + size - 1, Move(value)); }
+	return handle;
+}
+
+template<class Type>
+template<class... Parameters>
+inline PoolHandle Pool<Type>::Emplace(Parameters&&... parameters) noexcept
+{
+	PoolHandle handle = Acquire();
+	if (handle != InvalidPoolHandle) { Construct<Type, Parameters...>(dense + size - 1, Forward<Parameters>(parameters)...); }
+	return handle;
+}
+
+template<class Type>
+inline PoolHandle Pool<Type>::Acquire()
+{
+	if (size == capacity)
+	{
+		if (capacity == MaxCapacity) { return InvalidPoolHandle; }
+		Reserve(capacity ? capacity * 2 : 16);
+	}
+
+	U32 slotIndex;
+
+	if (freeSlot != U32_MAX)
+	{
+		slotIndex = freeSlot;
+		freeSlot = slots[slotIndex].index;
+	}
+	else
+	{
+		slotIndex = slotCount++;
+		slots[slotIndex].generation = 0;
+	}
+
+	Slot& slot = slots[slotIndex];
+	slot.index = size;
+	owners[size++] = slotIndex;
+
+	return (slot.generation << IndexBits) | slotIndex;
+}
+
+template<class Type>
+inline bool Pool<Type>::Remove(PoolHandle handle)
+{
+	if (!Valid(handle)) { return false; }
+
+	U32 slotIndex = handle & IndexMask;
+	Slot& slot = slots[slotIndex];
+	U32 index = slot.index;
+	U32 last = --size;
+
+	if constexpr (IsDestructible<Type>) { dense[index].~Type(); }
+
+	//Keep the objects contiguous by moving the last one into the hole
+	if (index != last)
+	{
+		memcpy(dense + index, dense + last, sizeof(Type));
+		owners[index] = owners[last];
+		slots[owners[index]].index = index;
+	}
+
+	slot.generation = (slot.generation + 1) & GenerationMask;
+	slot.index = freeSlot;
+	freeSlot = slotIndex;
+
+	return true;
+}
+
+template<class Type>
+inline Type* Pool<Type>::Get(PoolHandle handle)
+{
+	if (!Valid(handle)) { return nullptr; }
+	return dense + slots[handle & IndexMask].index;
+}
+
+template<class Type>
+inline const Type* Pool<Type>::Get(PoolHandle handle) const
+{
+	if (!Valid(handle)) { return nullptr; }
+	return dense + slots[handle & IndexMask].index;
+}
+
+template<class Type>
+inline bool Pool<Type>::Valid(PoolHandle handle) const
+{
+	U32 slotIndex = handle & IndexMask;
+	if (handle == InvalidPoolHandle || slotIndex >= slotCount) { return false; }
+
+	const Slot& slot = slots[slotIndex];
+
+	//Free slots have already moved on to the next generation
+	return slot.generation == handle >> IndexBits && slot.index < size && owners[slot.index] == slotIndex;
+}
+
+template<class Type>
+inline PoolHandle Pool<Type>::Handle(U32 index) const
+{
+	U32 slotIndex = owners[index];
+	return (slots[slotIndex].generation << IndexBits) | slotIndex;
+}
+
+template<class Type>
+inline void Pool<Type>::Reserve(U32 cap)
+{
+	if (cap <= capacity) { return; }
+	if (cap > MaxCapacity) { cap = MaxCapacity; }
+
+	U64 denseCapacity = Memory::Reallocate(&dense, cap, size, tag);
+	U64 ownerCapacity = Memory::Reallocate(&owners, cap, size, tag);
+	U64 slotCapacity = Memory::Reallocate(&slots, cap, slotCount, tag);
+
+	//The slot allocations round up separately, only use what all three fit
+	U64 fit = denseCapacity < ownerCapacity ? denseCapacity : ownerCapacity;
+	if (slotCapacity < fit) { fit = slotCapacity; }
+
+	capacity = fit < MaxCapacity ? (U32)fit : MaxCapacity;
+}
+
+template<class Type>
+inline U32 Pool<Type>::Capacity() const { return capacity; }
+
+template<class Type>
+inline U32 Pool<Type>::Size() const { return size; }
+
+template<class Type>
+inline bool Pool<Type>::Empty() const { return size == 0; }
+
+template<class Type>
+inline Type* Pool<Type>::Data() { return dense; }
+
+template<class Type>
+inline const Type* Pool<Type>::Data() const { return dense; }
+
+template<class Type>
+inline Type* Pool<Type>::begin() { return dense; }
+
+template<class Type>
+inline Type* Pool<Type>::end() { return dense + size; }
+
+template<class Type>
+inline const Type* Pool<Type>::begin() const { return dense; }
+
+template<class Type>
+inline const Type* Pool<Type>::end() const { return dense + size; }
@@ -0,0 +1,833 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "Vector.hpp"
+
+/// <summary>
+/// Vector that keeps up to InlineCapacity elements inside itself and only allocates once it outgrows them, meant for short lists
+/// that would otherwise each take a slab slot and a pointer chase. Holds no pointer into itself, and its elements are trivially
+/// copyable, so like Vector it can be relocated with memcpy by the containers it lives in
+/// </summary>
+template<class Type, U64 InlineCapacity>
+struct SmallVector
+{
+	static_assert(InlineCapacity > 0, "SmallVector Needs An Inline Capacity!");
+	static_assert(IsTriviallyCopyable<Type>, "SmallVector Elements Must Be Trivially Copyable, Inline Ones Get Moved With memcpy!");
+
+	SmallVector();
+	SmallVector(U64 capacity);
+	SmallVector(U64 size, const Type& value);
+	SmallVector(std::initializer_list<Type> list);
+	SmallVector(MemoryTag tag, U64 capacity = 0);
+	SmallVector(const SmallVector& other);
+	SmallVector(SmallVector&& other) noexcept;
+	SmallVector(const Vector<Type>& other);
+
+	SmallVector& operator=(const SmallVector& other);
+	SmallVector& operator=(SmallVector&& other) noexcept;
+	SmallVector& operator=(const Vector<Type>& other);
+
+	~SmallVector();
+	void Destroy();
+
+	Type& Push(const Type& value);
+	Type& Push(Type&& value) noexcept;
+	Type* PushEmpty();
+	void PushRange(const Type* values, U64 count);
+	void PushRange(std::initializer_list<Type> list);
+	Type* Append(U64 count);
+	template <class... Parameters> Type& Emplace(Parameters&&... parameters) noexcept;
+	template <Unsigned I, class... Parameters> Type& EmplaceAt(I index, Parameters&&... parameters) noexcept;
+
+	void Pop();
+	void Pop(Type& value);
+
+	template<Unsigned Index> Type& Insert(Index index, const Type& value);
+	template<Unsigned Index> Type& Insert(Index index, Type&& value) noexcept;
+	template<Unsigned Index> void Insert(Index index, const SmallVector& other);
+	template<Unsigned Index> void Insert(Index index, SmallVector&& other) noexcept;
+
+	void Remove(U64 index);
+	void Remove(U64 index, Type& value);
+	I32 RemoveSwap(U64 index);
+	I32 RemoveSwap(U64 index, Type& value);
+	void Erase(U64 index0, U64 index1);
+	void Erase(U64 index0, U64 index1, SmallVector& other);
+	void Split(U64 index, SmallVector& other);
+	void Merge(const SmallVector& other);
+	void Merge(SmallVector&& other) noexcept;
+
+	SmallVector& operator+=(const SmallVector& other);
+	SmallVector& operator+=(SmallVector&& other) noexcept;
+
+	template<FunctionPtr Predicate> void SearchFor(Predicate predicate, SmallVector& other);
+	template<FunctionPtr Predicate> void SearchForIndices(Predicate predicate, Vector<U64>& other);
+	template<FunctionPtr Predicate> U64 SearchCount(Predicate predicate);
+	template<FunctionPtr Predicate> U64 RemoveAll(Predicate predicate);
+	template<FunctionPtr Predicate> void RemoveAll(Predicate predicate, SmallVector& other);
+	template<FunctionPtr Predicate> Type* Find(Predicate predicate) const;
+	template<FunctionPtr Predicate> U64 SortedInsert(Predicate predicate, const Type& value);
+	template<FunctionPtr Predicate> U64 SortedInsert(Predicate predicate, Type&& value) noexcept;
+
+	void Sort();
+	template<FunctionPtr Predicate> void Sort(Predicate predicate);
+	void StableSort();
+	template<FunctionPtr Predicate> void StableSort(Predicate predicate);
+	void RadixSort();
+	template<class KeyFunction> void RadixSort(KeyFunction key);
+	U64 LowerBound(const Type& value) const;
+	template<FunctionPtr Predicate> U64 LowerBound(Predicate predicate, const Type& value) const;
+	U64 UpperBound(const Type& value) const;
+	template<FunctionPtr Predicate> U64 UpperBound(Predicate predicate, const Type& value) const;
+
+	/// <summary>
+	/// Makes room for capacity elements, moving out of the inline storage if it doesn't fit, never shrinks
+	/// </summary>
+	void Reserve(U64 capacity);
+	void Resize(U64 size);
+	void Resize(U64 size, const Type& value);
+	void Clear();
+
+	bool Contains(const Type& value) const;
+	U64 Count(const Type& value) const;
+	U64 Find(const Type& value) const;
+	U64 Index(const Type* value) const;
+
+	U64 Size() const { return size; }
+	U64 Capacity() const { return capacity; }
+	bool Empty() const { return size == 0; }
+	bool Full() const { return size == capacity; }
+
+	/// <summary>
+	/// True while the elements are stored inside the SmallVector itself
+	/// </summary>
+	bool Inline() const { return capacity <= InlineCapacity; }
+
+	const Type* Data() const { return Array(); }
+	Type* Data() { return Array(); }
+
+	const Type& Get(U64 i) const { return Array()[i]; }
+	Type& Get(U64 i) { return Array()[i]; }
+	const Type& operator[](U64 i) const { if (i >= size) { BreakPoint; } return Array()[i]; }
+	Type& operator[](U64 i) { if (i >= size) { BreakPoint; } return Array()[i]; }
+
+	Type& Front() { return *Array(); }
+	const Type& Front() const { return *Array(); }
+	Type& Back() { return Array()[size - 1]; }
+	const Type& Back() const { return Array()[size - 1]; }
+
+	bool operator==(const SmallVector& other) const;
+	bool operator!=(const SmallVector& other) const;
+
+	Type* begin() { return Array(); }
+	Type* end() { return Array() + size; }
+	const Type* begin() const { return Array(); }
+	const Type* end() const { return Array() + size; }
+
+private:
+	Type* Array() { return Inline() ? (Type*)storage : heap; }
+	const Type* Array() const { return Inline() ? (const Type*)storage : heap; }
+
+	void Grow(U64 required);
+	void Release();
+
+	U64 size = 0;
+	U64 capacity = InlineCapacity;	//Only more than InlineCapacity once spilled to heap, zero in zero-filled memory still means inline
+
+	union
+	{
+		Type* heap;
+		alignas(Type) U8 storage[sizeof(Type) * InlineCapacity];
+	};
+
+	MemoryTag tag = MemoryTag::Current;
+};
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector() {}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(U64 cap) { Reserve(cap); }
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(U64 size, const Type& value)
+{
+	Resize(size, value);
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(std::initializer_list<Type> list)
+{
+	PushRange(list.begin(), list.size());
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(MemoryTag tag, U64 cap) : tag(tag) { Reserve(cap); }
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(const SmallVector& other) : tag(other.tag)
+{
+	PushRange(other.Array(), other.size);
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(SmallVector&& other) noexcept : size(other.size), capacity(other.capacity), tag(other.tag)
+{
+	//Heap arrays change hands, inline elements have to be moved over one by one
+	if (other.Inline()) { MoveData((Type*)storage, (Type*)other.storage, size); }
+	else { heap = other.heap; }
+
+	other.size = 0;
+	other.capacity = InlineCapacity;
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::SmallVector(const Vector<Type>& other)
+{
+	PushRange(other.Data(), other.Size());
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>& SmallVector<Type, InlineCapacity>::operator=(const SmallVector& other)
+{
+	if (this == &other) { return *this; }
+
+	Clear();
+	PushRange(other.Array(), other.size);
+
+	return *this;
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>& SmallVector<Type, InlineCapacity>::operator=(SmallVector&& other) noexcept
+{
+	if (this == &other) { return *this; }
+
+	Destroy();
+
+	size = other.size;
+	capacity = other.capacity;
+	tag = other.tag;
+
+	if (other.Inline()) { MoveData((Type*)storage, (Type*)other.storage, size); }
+	else { heap = other.heap; }
+
+	other.size = 0;
+	other.capacity = InlineCapacity;
+
+	return *this;
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>& SmallVector<Type, InlineCapacity>::operator=(const Vector<Type>& other)
+{
+	Clear();
+	PushRange(other.Data(), other.Size());
+
+	return *this;
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>::~SmallVector() { Destroy(); }
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Destroy()
+{
+	Clear();
+	Release();
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Release()
+{
+	if (!Inline()) { Memory::Free(&heap); }
+
+	capacity = InlineCapacity;
+}
+
+template<class Type, U64 InlineCapacity>
+inline Type& SmallVector<Type, InlineCapacity>::Push(const Type& value)
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	return Construct<Type>(Array() + size++, value);
+}
+
+template<class Type, U64 InlineCapacity>
+inline Type& SmallVector<Type, InlineCapacity>::Push(Type&& value) noexcept
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	return Construct<Type>(Array() + size++, Move(value));
+}
+
+template<class Type, U64 InlineCapacity>
+inline Type* SmallVector<Type, InlineCapacity>::PushEmpty()
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	return Array() + size++;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::PushRange(const Type* values, U64 count)
+{
+	if (size + count > capacity) { Grow(size + count); }
+
+	CopyData(Array() + size, values, count);
+	size += count;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::PushRange(std::initializer_list<Type> list)
+{
+	PushRange(list.begin(), list.size());
+}
+
+template<class Type, U64 InlineCapacity>
+inline Type* SmallVector<Type, InlineCapacity>::Append(U64 count)
+{
+	if (size + count > capacity) { Grow(size + count); }
+
+	Type* first = Array() + size;
+	size += count;
+	return first;
+}
+
+template<class Type, U64 InlineCapacity>
+template <class... Parameters>
+inline Type& SmallVector<Type, InlineCapacity>::Emplace(Parameters&&... parameters) noexcept
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	return Construct<Type, Parameters...>(Array() + size++, Forward<Parameters>(parameters)...);
+}
+
+template<class Type, U64 InlineCapacity>
+template <Unsigned I, class... Parameters>
+inline Type& SmallVector<Type, InlineCapacity>::EmplaceAt(I index, Parameters&&... parameters) noexcept
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	return Construct<Type, Parameters...>(Array() + index, Forward<Parameters>(parameters)...);
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Pop()
+{
+	if (size)
+	{
+		if constexpr (IsDestructible<Type>) { (Array() + size - 1)->~Type(); }
+		--size;
+	}
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Pop(Type& value)
+{
+	if (size) { Construct<Type>(&value, Move(Array()[--size])); }
+}
+
+template<class Type, U64 InlineCapacity>
+template<Unsigned I>
+inline Type& SmallVector<Type, InlineCapacity>::Insert(I index, const Type& value)
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	Type* array = Array();
+	MoveData(array + index + 1, array + index, (size - index));
+	++size;
+	return Construct<Type>(array + index, value);
+}
+
+template<class Type, U64 InlineCapacity>
+template<Unsigned I>
+inline Type& SmallVector<Type, InlineCapacity>::Insert(I index, Type&& value) noexcept
+{
+	if (size == capacity) { Grow(size + 1); }
+
+	Type* array = Array();
+	MoveData(array + index + 1, array + index, (size - index));
+	++size;
+	return Construct<Type>(array + index, Move(value));
+}
+
+template<class Type, U64 InlineCapacity>
+template<Unsigned I>
+inline void SmallVector<Type, InlineCapacity>::Insert(I index, const SmallVector& other)
+{
+	if (size + other.size > capacity) { Grow(size + other.size); }
+
+	Type* array = Array();
+	MoveData(array + index + other.size, array + index, (size - index));
+	CopyData(array + index, other.Array(), other.size);
+
+	size += other.size;
+}
+
+template<class Type, U64 InlineCapacity>
+template<Unsigned I>
+inline void SmallVector<Type, InlineCapacity>::Insert(I index, SmallVector&& other) noexcept
+{
+	if (size + other.size > capacity) { Grow(size + other.size); }
+
+	Type* array = Array();
+	MoveData(array + index + other.size, array + index, (size - index));
+	MoveData(array + index, other.Array(), other.size);
+	size += other.size;
+
+	other.Destroy();
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Remove(U64 index)
+{
+	Type* array = Array();
+	if constexpr (IsDestructible<Type>) { array[index].~Type(); }
+	MoveData(array + index, array + index + 1, (size - index - 1));
+
+	--size;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Remove(U64 index, Type& value)
+{
+	Type* array = Array();
+	Construct<Type>(&value, Move(array[index]));
+	MoveData(array + index, array + index + 1, (size - index - 1));
+
+	--size;
+}
+
+template<class Type, U64 InlineCapacity>
+inline I32 SmallVector<Type, InlineCapacity>::RemoveSwap(U64 index)
+{
+	Type* array = Array();
+
+	if (index < size - 1)
+	{
+		Assign(array + index, Move(array[--size]));
+		return (I32)size;
+	}
+
+	--size;
+	return -1;
+}
+
+template<class Type, U64 InlineCapacity>
+inline I32 SmallVector<Type, InlineCapacity>::RemoveSwap(U64 index, Type& value)
+{
+	Type* array = Array();
+	Construct<Type>(&value, Move(array[index]));
+
+	if (index < size - 1)
+	{
+		Construct<Type>(array + index, Move(array[--size]));
+		return (I32)size;
+	}
+
+	--size;
+	return -1;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Erase(U64 index0, U64 index1)
+{
+	Type* array = Array();
+	if constexpr (IsDestructible<Type>)
+	{
+		for (Type* t = array + index0, *end = array + index1; t != end; ++t) { t->~Type(); }
+	}
+
+	MoveData(array + index0, array + index1, (size - index1));
+
+	size -= index1 - index0;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Erase(U64 index0, U64 index1, SmallVector& other)
+{
+	other.Clear();
+	other.Reserve(index1 - index0);
+	other.size = index1 - index0;
+
+	Type* array = Array();
+	MoveData(other.Array(), array + index0, (index1 - index0));
+	MoveData(array + index0, array + index1, (size - index1));
+
+	size -= index1 - index0;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Split(U64 index, SmallVector& other)
+{
+	other.Clear();
+	other.Reserve(size - index);
+	other.size = size - index;
+
+	MoveData(other.Array(), Array() + index, other.size);
+
+	size = index;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Merge(const SmallVector& other)
+{
+	PushRange(other.Array(), other.size);
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Merge(SmallVector&& other) noexcept
+{
+	if (size + other.size > capacity) { Grow(size + other.size); }
+
+	MoveData(Array() + size, other.Array(), other.size);
+	size += other.size;
+
+	other.Destroy();
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>& SmallVector<Type, InlineCapacity>::operator+=(const SmallVector& other)
+{
+	Merge(other);
+	return *this;
+}
+
+template<class Type, U64 InlineCapacity>
+inline SmallVector<Type, InlineCapacity>& SmallVector<Type, InlineCapacity>::operator+=(SmallVector&& other) noexcept
+{
+	Merge(Move(other));
+	return *this;
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline void SmallVector<Type, InlineCapacity>::SearchFor(Predicate predicate, SmallVector& other)
+{
+	other.Clear();
+	other.Reserve(size);
+
+	for (Type* t = Array(), *end = t + size; t != end; ++t)
+	{
+		if (predicate(*t)) { other.Push(*t); }
+	}
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline void SmallVector<Type, InlineCapacity>::SearchForIndices(Predicate predicate, Vector<U64>& other)
+{
+	other.Reserve(size);
+	other.Clear();
+
+	U64 i = 0;
+	for (Type* t = Array(), *end = t + size; t != end; ++t, ++i)
+	{
+		if (predicate(*t)) { other.Push(i); }
+	}
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::SearchCount(Predicate predicate)
+{
+	U64 i = 0;
+	for (Type* t = Array(), *end = t + size; t != end; ++t)
+	{
+		if (predicate(*t)) { ++i; }
+	}
+
+	return i;
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::RemoveAll(Predicate predicate)
+{
+	U64 i = 0;
+	for (Type* t = Array(); t != Array() + size;)
+	{
+		if (predicate(*t))
+		{
+			++i;
+			if constexpr (IsDestructible<Type>) { t->~Type(); }
+			MoveData(t, t + 1, (Array() + size - t - 1));
+			--size;
+		}
+		else { ++t; }
+	}
+
+	return i;
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline void SmallVector<Type, InlineCapacity>::RemoveAll(Predicate predicate, SmallVector& other)
+{
+	other.Clear();
+	other.Reserve(size);
+
+	for (Type* t = Array(); t != Array() + size;)
+	{
+		if (predicate(*t))
+		{
+			other.Push(Move(*t));
+			MoveData(t, Array() + size-- - 1, 1);
+		}
+		else { ++t; }
+	}
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline Type* SmallVector<Type, InlineCapacity>::Find(Predicate predicate) const
+{
+	for (Type* t = (Type*)Array(), *end = t + size; t != end; ++t)
+	{
+		if (predicate(t)) { return t; }
+	}
+
+	return nullptr;
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::SortedInsert(Predicate predicate, const Type& value)
+{
+	U64 index = UpperBound(predicate, value);
+	Insert(index, value);
+
+	return index;
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::SortedInsert(Predicate predicate, Type&& value) noexcept
+{
+	U64 index = UpperBound(predicate, value);
+	Insert(index, Move(value));
+
+	return index;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Sort()
+{
+	Sort([](const Type& a, const Type& b) { return a < b; });
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline void SmallVector<Type, InlineCapacity>::Sort(Predicate predicate)
+{
+	if (size < 2) { return; }
+
+	Vector<Type>::IntroSort(Array(), Array() + size, DegreeOfTwo(size) * 2, predicate);
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::StableSort()
+{
+	StableSort([](const Type& a, const Type& b) { return a < b; });
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline void SmallVector<Type, InlineCapacity>::StableSort(Predicate predicate)
+{
+	Vector<Type>::MergeSort(Array(), size, tag, predicate);
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::RadixSort()
+{
+	RadixSort([](const Type& value) { return value; });
+}
+
+template<class Type, U64 InlineCapacity>
+template<class KeyFunction>
+inline void SmallVector<Type, InlineCapacity>::RadixSort(KeyFunction key)
+{
+	Vector<Type>::LsdRadixSort(Array(), size, tag, key);
+}
+
+template<class Type, U64 InlineCapacity>
+inline U64 SmallVector<Type, InlineCapacity>::LowerBound(const Type& value) const
+{
+	return LowerBound([](const Type& a, const Type& b) { return a < b; }, value);
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::LowerBound(Predicate predicate, const Type& value) const
+{
+	const Type* array = Array();
+	U64 first = 0;
+	U64 count = size;
+
+	while (count)
+	{
+		U64 step = count / 2;
+
+		if (predicate(array[first + step], value))
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else { count = step; }
+	}
+
+	return first;
+}
+
+template<class Type, U64 InlineCapacity>
+inline U64 SmallVector<Type, InlineCapacity>::UpperBound(const Type& value) const
+{
+	return UpperBound([](const Type& a, const Type& b) { return a < b; }, value);
+}
+
+template<class Type, U64 InlineCapacity>
+template<FunctionPtr Predicate>
+inline U64 SmallVector<Type, InlineCapacity>::UpperBound(Predicate predicate, const Type& value) const
+{
+	const Type* array = Array();
+	U64 first = 0;
+	U64 count = size;
+
+	while (count)
+	{
+		U64 step = count / 2;
+
+		if (!predicate(value, array[first + step]))
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else { count = step; }
+	}
+
+	return first;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Reserve(U64 cap)
+{
+	if (cap <= capacity) { return; }
+
+	if (Inline())
+	{
+		if (cap <= InlineCapacity) { capacity = InlineCapacity; return; }
+
+		//Leaving the inline storage, heap overlaps it so the elements go through a new array first
+		Type* array = nullptr;
+		U64 newCapacity = Memory::Allocate(&array, cap, tag);
+		MoveData(array, (Type*)storage, size);
+
+		heap = array;
+		capacity = newCapacity;
+	}
+	else { capacity = Memory::Reallocate(&heap, cap, size, tag); }
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Grow(U64 required)
+{
+	U64 grown = capacity + capacity / 2;
+	Reserve(grown > required ? grown : required);
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Resize(U64 size)
+{
+	if (size > capacity) { Reserve(size); }
+	this->size = size;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Resize(U64 size, const Type& value)
+{
+	if (size > capacity) { Reserve(size); }
+
+	Type* array = Array();
+	for (U64 i = this->size; i < size; ++i) { Construct<Type>(array + i, value); }
+
+	this->size = size;
+}
+
+template<class Type, U64 InlineCapacity>
+inline void SmallVector<Type, InlineCapacity>::Clear()
+{
+	if constexpr (IsDestructible<Type>)
+	{
+		for (Type* t = Array(), *end = t + size; t != end; ++t) { t->~Type(); }
+	}
+
+	size = 0;
+}
+
+template<class Type, U64 InlineCapacity>
+inline bool SmallVector<Type, InlineCapacity>::Contains(const Type& value) const
+{
+	for (const Type* t = Array(), *end = t + size; t != end; ++t)
+	{
+		if (*t == value) { return true; }
+	}
+
+	return false;
+}
+
+template<class Type, U64 InlineCapacity>
+inline U64 SmallVector<Type, InlineCapacity>::Count(const Type& value) const
+{
+	U64 count = 0;
+	for (const Type* t = Array(), *end = t + size; t != end; ++t)
+	{
+		if (*t == value) { ++count; }
+	}
+
+	return count;
+}
+
+template<class Type, U64 InlineCapacity>
+inline U64 SmallVector<Type, InlineCapacity>::Find(const Type& value) const
+{
+	const Type* array = Array();
+	for (U64 i = 0; i < size; ++i)
+	{
+		if (array[i] == value) { return i; }
+	}
+
+	return U64_MAX;
+}
+
+template<class Type, U64 InlineCapacity>
+inline U64 SmallVector<Type, InlineCapacity>::Index(const Type* value) const
+{
+	const Type* array = Array();
+	if (value < array || value >= array + capacity) { return U64_MAX; }
+
+	return value - array;
+}
+
+template<class Type, U64 InlineCapacity>
+inline bool SmallVector<Type, InlineCapacity>::operator==(const SmallVector& other) const
+{
+	if (this == &other) { return true; }
+
+	if (size != other.size) { return false; }
+
+	for (const Type* it0 = Array(), *it1 = other.Array(), *end = it0 + size; it0 != end; ++it0, ++it1)
+	{
+		if (*it0 != *it1) { return false; }
+	}
+
+	return true;
+}
+
+template<class Type, U64 InlineCapacity>
+inline bool SmallVector<Type, InlineCapacity>::operator!=(const SmallVector& other) const
+{
+	return !(*this == other);
+}
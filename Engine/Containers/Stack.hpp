@@ -62,7 +62,7 @@ template <class Type>
 inline Stack<Type>& Stack<Type>::operator=(const Stack& other)
 {
 	size = other.size;
-	if (capacity < other.size) { capacity = Memory::Reallocate(&array, size); }
+	if (capacity < other.size) { capacity = Memory::Reallocate(&array, size, 0); }
 
 	CopyData(array, other.array, size);
 
@@ -138,7 +138,7 @@ inline bool Stack<Type>::Pop(Type& value)
 }
 
 template <class Type>
-inline void Stack<Type>::Reserve(U64 cap) { capacity = Memory::Reallocate(&array, cap); }
+inline void Stack<Type>::Reserve(U64 cap) { capacity = Memory::Reallocate(&array, cap, size); }
 
 template <class Type>
 inline U64 Stack<Type>::Capacity() const { return capacity; }
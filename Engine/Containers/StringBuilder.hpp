@@ -0,0 +1,339 @@
+#pragma once
+
+#include "Defines.hpp"
+
+#include "String.hpp"
+
+#ifndef STRING_BUILDER_INLINE_CAPACITY
+#	define STRING_BUILDER_INLINE_CAPACITY 512	//Characters a StringBuilder holds in place before it needs a chunk
+#endif
+
+#ifndef STRING_BUILDER_CHUNK_CAPACITY
+#	define STRING_BUILDER_CHUNK_CAPACITY 1024	//Smallest chunk a StringBuilder allocates once it outgrows its inline buffer
+#endif
+
+/// <summary>
+/// Assembles text out of formatted pieces without reallocating. Pieces fill an inline buffer, then a chain of chunks that are kept
+/// across Clear, so a reused builder stops allocating. Each Append sizes all of its arguments up front and checks capacity once,
+/// the result is copied out once by ToString or handed over chunk by chunk with ForEachChunk
+/// </summary>
+template<Character C>
+struct StringBuilderBase
+{
+	StringBuilderBase();
+	StringBuilderBase(MemoryTag tag);
+
+	/// <summary>
+	/// Takes its chunks from the frame arena, the builder must be cleared or destroyed within the frame it was used in
+	/// </summary>
+	StringBuilderBase(FrameTag);
+
+	StringBuilderBase(const StringBuilderBase&) = delete;
+	StringBuilderBase(StringBuilderBase&&) = delete;
+	StringBuilderBase& operator=(const StringBuilderBase&) = delete;
+	StringBuilderBase& operator=(StringBuilderBase&&) = delete;
+
+	~StringBuilderBase();
+	void Destroy();
+
+	/// <summary>
+	/// Empties the builder, its chunks are kept for reuse unless they came from the frame arena
+	/// </summary>
+	void Clear();
+
+	template<class... Args> StringBuilderBase& Append(const Args&... args);
+	StringBuilderBase& Append(const C* string, U64 length);
+
+	StringBase<C> ToString() const;
+	StringBase<C> ToString(FrameTag) const;
+
+	/// <summary>
+	/// Joins the chunks if there are several and terminates the text, valid until the next Append, Clear or Destroy
+	/// </summary>
+	const C* Data();
+	StringView View() requires IsSame<C, C8>;
+
+	/// <summary>
+	/// Calls function as void(const C*, U64) on each non-empty piece of the text in order
+	/// </summary>
+	template<class Function> void ForEachChunk(Function&& function) const;
+
+	U64 Size() const;
+	bool Empty() const;
+
+	static constexpr inline U64 InlineCapacity = STRING_BUILDER_INLINE_CAPACITY;
+
+private:
+	struct Chunk
+	{
+		Chunk* next;
+		U64 size;
+		U64 capacity;	//Characters that fit after the header, one is always left for a terminator
+
+		C* Data() { return reinterpret_cast<C*>(this + 1); }
+		const C* Data() const { return reinterpret_cast<const C*>(this + 1); }
+	};
+
+	C* Reserve(U64 length);
+	void Gather(StringBase<C>& string) const;
+	Chunk* NextChunk(Chunk* after, U64 length);
+
+	template<class Type> static U64 ArgLength(const Type& arg);
+	template<class Type> static U64 Write(C* buffer, const Type& arg);
+
+	U64 size = 0;
+	U64 localSize = 0;
+	Chunk* first = nullptr;
+	Chunk* current = nullptr;	//Chunk being written to, nullptr while the text still fits in local
+	MemoryTag tag = MemoryTag::Current;
+	bool frame = false;			//Chunks come from the frame arena and are dropped on Clear
+
+	C local[InlineCapacity];
+};
+
+using StringBuilder = StringBuilderBase<C8>;
+using StringBuilder16 = StringBuilderBase<C16>;
+using StringBuilder32 = StringBuilderBase<C32>;
+using StringBuilderW = StringBuilderBase<CW>;
+
+template<Character C>
+inline StringBuilderBase<C>::StringBuilderBase() {}
+
+template<Character C>
+inline StringBuilderBase<C>::StringBuilderBase(MemoryTag tag) : tag(tag) {}
+
+template<Character C>
+inline StringBuilderBase<C>::StringBuilderBase(FrameTag) : frame(true) {}
+
+template<Character C>
+inline StringBuilderBase<C>::~StringBuilderBase()
+{
+	Destroy();
+}
+
+template<Character C>
+inline void StringBuilderBase<C>::Destroy()
+{
+	//Memory::Free does nothing on frame memory, but the arena falls back to the heap once it's full
+	while (first)
+	{
+		Chunk* next = first->next;
+		Memory::Free(&first);
+		first = next;
+	}
+
+	current = nullptr;
+	size = 0;
+	localSize = 0;
+}
+
+template<Character C>
+inline void StringBuilderBase<C>::Clear()
+{
+	if (frame) { Destroy(); return; }
+
+	for (Chunk* chunk = first; chunk; chunk = chunk->next) { chunk->size = 0; }
+
+	current = nullptr;
+	size = 0;
+	localSize = 0;
+}
+
+template<Character C>
+template<class... Args>
+inline StringBuilderBase<C>& StringBuilderBase<C>::Append(const Args&... args)
+{
+	C* buffer = Reserve((ArgLength(args) + ...));
+
+	U64 written = 0;
+	((written += Write(buffer + written, args)), ...);
+
+	if (current) { current->size += written; }
+	else { localSize += written; }
+
+	size += written;
+
+	return *this;
+}
+
+template<Character C>
+inline StringBuilderBase<C>& StringBuilderBase<C>::Append(const C* string, U64 length)
+{
+	C* buffer = Reserve(length);
+	memcpy(buffer, string, length * sizeof(C));
+
+	if (current) { current->size += length; }
+	else { localSize += length; }
+
+	size += length;
+
+	return *this;
+}
+
+template<Character C>
+inline StringBase<C> StringBuilderBase<C>::ToString() const
+{
+	StringBase<C> string(tag, size);
+	Gather(string);
+
+	return string;
+}
+
+template<Character C>
+inline StringBase<C> StringBuilderBase<C>::ToString(FrameTag) const
+{
+	StringBase<C> string(FRAME, size);
+	Gather(string);
+
+	return string;
+}
+
+template<Character C>
+inline const C* StringBuilderBase<C>::Data()
+{
+	if (!current)
+	{
+		local[localSize] = 0;
+		return local;
+	}
+
+	if (localSize || current != first || first->size != size)
+	{
+		//Joined text goes to the front of the chain, the chunks it was gathered from stay behind it for reuse
+		Chunk* joined = NextChunk(nullptr, size);
+		U64 length = 0;
+
+		if (localSize) { memcpy(joined->Data(), local, localSize * sizeof(C)); length = localSize; }
+
+		for (Chunk* chunk = joined->next; chunk; chunk = chunk->next)
+		{
+			memcpy(joined->Data() + length, chunk->Data(), chunk->size * sizeof(C));
+			length += chunk->size;
+			chunk->size = 0;
+		}
+
+		joined->size = length;
+		localSize = 0;
+		current = joined;
+	}
+
+	current->Data()[size] = 0;
+	return current->Data();
+}
+
+template<Character C>
+inline StringView StringBuilderBase<C>::View() requires IsSame<C, C8>
+{
+	const C8* data = Data();
+	return { data, size + 1 };
+}
+
+template<Character C>
+template<class Function>
+inline void StringBuilderBase<C>::ForEachChunk(Function&& function) const
+{
+	if (localSize) { function(local, localSize); }
+
+	for (const Chunk* chunk = first; chunk; chunk = chunk->next)
+	{
+		if (chunk->size) { function(chunk->Data(), chunk->size); }
+	}
+}
+
+template<Character C>
+inline U64 StringBuilderBase<C>::Size() const
+{
+	return size;
+}
+
+template<Character C>
+inline bool StringBuilderBase<C>::Empty() const
+{
+	return size == 0;
+}
+
+template<Character C>
+inline C* StringBuilderBase<C>::Reserve(U64 length)
+{
+	//Text is never split across chunks, so an Append always writes into one contiguous run
+	if (!current)
+	{
+		if (localSize + length < InlineCapacity) { return local + localSize; }
+
+		current = NextChunk(nullptr, length);
+		return current->Data();
+	}
+
+	if (current->size + length < current->capacity) { return current->Data() + current->size; }
+
+	current = NextChunk(current, length);
+	return current->Data();
+}
+
+template<Character C>
+inline void StringBuilderBase<C>::Gather(StringBase<C>& string) const
+{
+	C* data = string.Data();
+
+	ForEachChunk([&](const C* piece, U64 length) { memcpy(data, piece, length * sizeof(C)); data += length; });
+
+	*data = 0;
+	string.size = size;
+}
+
+template<Character C>
+inline StringBuilderBase<C>::Chunk* StringBuilderBase<C>::NextChunk(Chunk* after, U64 length)
+{
+	Chunk** link = after ? &after->next : &first;
+
+	//A kept chunk is reused if the text fits, otherwise a bigger one is linked in front of it
+	Chunk* chunk = *link;
+	if (chunk && chunk->size == 0 && length < chunk->capacity) { return chunk; }
+
+	U64 capacity = length + 1;
+	if (capacity < STRING_BUILDER_CHUNK_CAPACITY) { capacity = STRING_BUILDER_CHUNK_CAPACITY; }
+	if (after && capacity < after->capacity * 2) { capacity = after->capacity * 2; }
+
+	U8* memory = nullptr;
+	U64 bytes;
+
+	if (frame) { bytes = FrameArena::Allocate(&memory, sizeof(Chunk) + capacity * sizeof(C)); }
+	else { bytes = Memory::Allocate(&memory, sizeof(Chunk) + capacity * sizeof(C), tag); }
+
+	chunk = reinterpret_cast<Chunk*>(memory);
+	chunk->next = *link;
+	chunk->size = 0;
+	chunk->capacity = (bytes - sizeof(Chunk)) / sizeof(C);
+	*link = chunk;
+
+	return chunk;
+}
+
+template<Character C>
+template<class Type>
+inline U64 StringBuilderBase<C>::ArgLength(const Type& arg)
+{
+	if constexpr (IsStringLiteral<Type>) { return Length(arg); }
+	else if constexpr (IsStringType<Type> || IsStringViewType<Type>) { return arg.Size(); }
+	else { return StringBase<C>::template MaxFormatLength<Type>(); }
+}
+
+template<Character C>
+template<class Type>
+inline U64 StringBuilderBase<C>::Write(C* buffer, const Type& arg)
+{
+	//Strings are copied straight from the argument, formatting them would copy the whole string first
+	if constexpr (IsStringLiteral<Type> || IsStringType<Type> || IsStringViewType<Type>)
+	{
+		U64 length = ArgLength(arg);
+
+		if constexpr (IsStringLiteral<Type>) { memcpy(buffer, arg, length * sizeof(C)); }
+		else { memcpy(buffer, arg.Data(), length * sizeof(C)); }
+
+		return length;
+	}
+	else
+	{
+		return StringBase<C>::Format(buffer, arg);
+	}
+}
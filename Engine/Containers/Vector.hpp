@@ -6,6 +6,8 @@
 
 #include <initializer_list>
 
+template<class Type, U64 InlineCapacity> struct SmallVector;
+
 template<class Type>
 struct Vector
 {
@@ -33,6 +35,27 @@ struct Vector
 	/// <param name="list:">The initializer list</param>
 	Vector(std::initializer_list<Type> list);
 
+	/// <summary>
+	/// Creates a new Vector instance backed by the FrameArena, size will be zero, creates an array of size greater than or equal to sizeof(T) * capacity
+	/// <para/>WARNING: the array is only valid until the FrameArena comes back around to this frame
+	/// </summary>
+	/// <param name="capacity:">The capacity the array will be at</param>
+	Vector(FrameTag, U64 capacity);
+
+	/// <summary>
+	/// Create a new Vector instance backed by the FrameArena using an initializer list, size will equal the list size
+	/// <para/>WARNING: the array is only valid until the FrameArena comes back around to this frame
+	/// </summary>
+	/// <param name="list:">The initializer list</param>
+	Vector(FrameTag, std::initializer_list<Type> list);
+
+	/// <summary>
+	/// Creates a new Vector instance whose memory is charged to tag, size will be zero, creates an array of size greater than or equal to sizeof(T) * capacity if capacity isn't zero
+	/// </summary>
+	/// <param name="tag:">The subsystem that owns the array, kept when it grows</param>
+	/// <param name="capacity:">The capacity the array will be at</param>
+	Vector(MemoryTag tag, U64 capacity = 0);
+
 	/// <summary>
 	/// Creates a new Vector instance, capacity and size will be other's, creates an array of the same size and copies other's data into it
 	/// </summary>
@@ -92,6 +115,26 @@ struct Vector
 	/// <returns>Pointer to the new spot in the array</returns>
 	Type* PushEmpty();
 
+	/// <summary>
+	/// Copies count values onto the back of array, reallocates array at most once
+	/// </summary>
+	/// <param name="values:">The values to copy</param>
+	/// <param name="count:">The amount of values</param>
+	void PushRange(const Type* values, U64 count);
+
+	/// <summary>
+	/// Copies the values in list onto the back of array, reallocates array at most once
+	/// </summary>
+	/// <param name="list:">The initializer list</param>
+	void PushRange(std::initializer_list<Type> list);
+
+	/// <summary>
+	/// Increases size by count without constructing objects at the new indices, reallocates array at most once
+	/// </summary>
+	/// <param name="count:">The amount of spots to add</param>
+	/// <returns>Pointer to the first new spot in the array</returns>
+	Type* Append(U64 count);
+
 	/// <summary>
 	/// Increases size by one and constructs value into the back of array using the parameters, reallocates array if it's too small
 	/// </summary>
@@ -299,6 +342,72 @@ struct Vector
 
 
 
+	/// <summary>
+	/// Sorts array in ascending order using operator&lt;, equal values may be reordered
+	/// </summary>
+	void Sort();
+
+	/// <summary>
+	/// Sorts array based on a predicate using introsort, equal values may be reordered
+	/// </summary>
+	/// <param name="predicate:">A function to compare values, true if a goes before b: bool pred(const Type&amp; a, const Type&amp; b)</param>
+	template<FunctionPtr Predicate> void Sort(Predicate predicate);
+
+	/// <summary>
+	/// Sorts array in ascending order using operator&lt;, equal values keep their order
+	/// </summary>
+	void StableSort();
+
+	/// <summary>
+	/// Sorts array based on a predicate using merge sort, equal values keep their order, allocates a buffer the size of array
+	/// </summary>
+	/// <param name="predicate:">A function to compare values, true if a goes before b: bool pred(const Type&amp; a, const Type&amp; b)</param>
+	template<FunctionPtr Predicate> void StableSort(Predicate predicate);
+
+	/// <summary>
+	/// Sorts an array of integers or floats in ascending order, one pass per byte of the value, equal values keep their order
+	/// </summary>
+	void RadixSort();
+
+	/// <summary>
+	/// Sorts array in ascending order of an integer or float key, one pass per byte of the key, equal keys keep their order,
+	/// allocates a buffer the size of array
+	/// </summary>
+	/// <param name="key:">A function to get the key of a value: Key key(const Type&amp; value)</param>
+	template<class KeyFunction> void RadixSort(KeyFunction key);
+
+	/// <summary>
+	/// Finds the first index whose value isn't less than value using operator&lt;, array must be sorted
+	/// </summary>
+	/// <param name="value:">The value to search for</param>
+	/// <returns>The index, size if every value is less than value</returns>
+	U64 LowerBound(const Type& value) const;
+
+	/// <summary>
+	/// Finds the first index whose value doesn't go before value, array must be sorted by predicate
+	/// </summary>
+	/// <param name="predicate:">A function to compare values, true if a goes before b: bool pred(const Type&amp; a, const Type&amp; b)</param>
+	/// <param name="value:">The value to search for</param>
+	/// <returns>The index, size if every value goes before value</returns>
+	template<FunctionPtr Predicate> U64 LowerBound(Predicate predicate, const Type& value) const;
+
+	/// <summary>
+	/// Finds the first index whose value is greater than value using operator&lt;, array must be sorted
+	/// </summary>
+	/// <param name="value:">The value to search for</param>
+	/// <returns>The index, size if no value is greater than value</returns>
+	U64 UpperBound(const Type& value) const;
+
+	/// <summary>
+	/// Finds the first index whose value value goes before, array must be sorted by predicate
+	/// </summary>
+	/// <param name="predicate:">A function to compare values, true if a goes before b: bool pred(const Type&amp; a, const Type&amp; b)</param>
+	/// <param name="value:">The value to search for</param>
+	/// <returns>The index, size if value goes before no value</returns>
+	template<FunctionPtr Predicate> U64 UpperBound(Predicate predicate, const Type& value) const;
+
+
+
 	/// <summary>
 	/// Reallocates the array to be sizeof(T) * capacity
 	/// </summary>
@@ -457,6 +566,27 @@ struct Vector
 
 private:
 
+	/// <summary>
+	/// Reserves room for at least required values, capacity grows by at least half so repeated pushes stay amortized O(1),
+	/// Memory only rounds small arrays up to their region, past that every reallocation would otherwise be exact
+	/// </summary>
+	/// <param name="required:">The capacity needed</param>
+	void Grow(U64 required);
+
+	/// <summary>
+	/// Ranges this short or shorter are insertion sorted
+	/// </summary>
+	static constexpr inline U64 SortThreshold = 16;
+
+	template<FunctionPtr Predicate> static void IntroSort(Type* first, Type* last, U64 depth, Predicate& predicate);
+	template<FunctionPtr Predicate> static void InsertionSort(Type* first, Type* last, Predicate& predicate);
+	template<FunctionPtr Predicate> static void HeapSort(Type* first, Type* last, Predicate& predicate);
+	template<FunctionPtr Predicate> static void SiftDown(Type* first, U64 root, U64 count, Predicate& predicate);
+	template<FunctionPtr Predicate> static void MergeSort(Type* array, U64 size, MemoryTag tag, Predicate& predicate);
+	template<FunctionPtr Predicate> static void MergeRuns(Type* first, Type* middle, Type* last, Type* out, Predicate& predicate);
+	template<class KeyFunction> static void LsdRadixSort(Type* array, U64 size, MemoryTag tag, KeyFunction& key);
+	template<class Key> static constexpr auto RadixKey(Key key);
+
 	/// <summary>
 	/// The count of values inside array
 	/// </summary>
@@ -471,31 +601,51 @@ private:
 	/// A dynamically allocated array to store data
 	/// </summary>
 	Type* array = nullptr;
+
+	/// <summary>
+	/// The subsystem array's memory is charged to
+	/// </summary>
+	MemoryTag tag = MemoryTag::Current;
+
+	template<class, U64> friend struct SmallVector;
 };
 
 template<class Type> inline Vector<Type>::Vector() {}
 
-template<class Type> inline Vector<Type>::Vector(U64 cap) { capacity = Memory::Allocate(&array, cap); }
+template<class Type> inline Vector<Type>::Vector(U64 cap) { capacity = Memory::Allocate(&array, cap, tag); }
 
 template<class Type> inline Vector<Type>::Vector(U64 size, const Type& value) : size(size), capacity(size)
 {
-	capacity = Memory::Allocate(&array, capacity);
+	capacity = Memory::Allocate(&array, capacity, tag);
 	for (Type* t = array, *end = array + size; t != end; ++t) { *t = value; }
 }
 
 template<class Type> inline Vector<Type>::Vector(std::initializer_list<Type> list) : size(list.size()), capacity(size)
 {
-	capacity = Memory::Allocate(&array, capacity);
+	capacity = Memory::Allocate(&array, capacity, tag);
 	CopyData(array, list.begin(), size);
 }
 
+template<class Type> inline Vector<Type>::Vector(FrameTag, U64 cap) { capacity = FrameArena::Allocate(&array, cap); }
+
+template<class Type> inline Vector<Type>::Vector(FrameTag, std::initializer_list<Type> list) : size(list.size()), capacity(size)
+{
+	capacity = FrameArena::Allocate(&array, capacity);
+	CopyData(array, list.begin(), size);
+}
+
+template<class Type> inline Vector<Type>::Vector(MemoryTag tag, U64 cap) : tag(tag)
+{
+	if (cap) { capacity = Memory::Allocate(&array, cap, tag); }
+}
+
 template<class Type> inline Vector<Type>::Vector(const Vector<Type>& other) : size(other.size), capacity(other.size)
 {
-	capacity = Memory::Allocate(&array, capacity);
+	capacity = Memory::Allocate(&array, capacity, tag);
 	CopyData(array, other.array, size);
 }
 
-template<class Type> inline Vector<Type>::Vector(Vector<Type>&& other) noexcept : size(other.size), capacity(other.capacity), array(other.array)
+template<class Type> inline Vector<Type>::Vector(Vector<Type>&& other) noexcept : size(other.size), capacity(other.capacity), array(other.array), tag(other.tag)
 {
 	other.size = 0;
 	other.capacity = 0;
@@ -505,7 +655,7 @@ template<class Type> inline Vector<Type>::Vector(Vector<Type>&& other) noexcept
 template<class Type> inline Vector<Type>& Vector<Type>::operator=(const Vector<Type>& other)
 {
 	size = other.size;
-	if (capacity < other.size) { capacity = Memory::Reallocate(&array, size); }
+	if (capacity < other.size) { capacity = Memory::Reallocate(&array, size, 0, tag); }
 
 	CopyData(array, other.array, size);
 
@@ -518,6 +668,7 @@ template<class Type> inline Vector<Type>& Vector<Type>::operator=(Vector<Type>&&
 	size = other.size;
 	capacity = other.capacity;
 	array = other.array;
+	tag = other.tag;
 
 	other.size = 0;
 	other.capacity = 0;
@@ -546,30 +697,52 @@ template<class Type> inline void Vector<Type>::Destroy()
 
 template<class Type> inline Type& Vector<Type>::Push(const Type& value)
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	return Construct<Type>(array + size++, value);
 }
 
 template<class Type> inline Type& Vector<Type>::Push(Type&& value) noexcept
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	return Construct<Type>(array + size++, Move(value));
 }
 
 template<class Type> inline Type* Vector<Type>::PushEmpty()
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	return array + size++;
 }
 
+template<class Type> inline void Vector<Type>::PushRange(const Type* values, U64 count)
+{
+	if (size + count > capacity) { Grow(size + count); }
+
+	CopyData(array + size, values, count);
+	size += count;
+}
+
+template<class Type> inline void Vector<Type>::PushRange(std::initializer_list<Type> list)
+{
+	PushRange(list.begin(), list.size());
+}
+
+template<class Type> inline Type* Vector<Type>::Append(U64 count)
+{
+	if (size + count > capacity) { Grow(size + count); }
+
+	Type* first = array + size;
+	size += count;
+	return first;
+}
+
 template<class Type>
 template <class... Parameters>
 inline Type& Vector<Type>::Emplace(Parameters&&... parameters) noexcept
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	return Construct<Type, Parameters...>(array + size++, Forward<Parameters>(parameters)...);
 }
@@ -578,7 +751,7 @@ template<class Type>
 template <Unsigned I, class... Parameters>
 inline Type& Vector<Type>::EmplaceAt(I index, Parameters&&... parameters) noexcept
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	return Construct<Type, Parameters...>(array + index, Forward<Parameters>(parameters)...);
 }
@@ -601,7 +774,7 @@ template<class Type>
 template<Unsigned I>
 inline Type& Vector<Type>::Insert(I index, const Type& value)
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	MoveData(array + index + 1, array + index, (size - index));
 	++size;
@@ -612,7 +785,7 @@ template<class Type>
 template<Unsigned I>
 inline Type& Vector<Type>::Insert(I index, Type&& value) noexcept
 {
-	if (size == capacity) { Reserve(capacity + 1); }
+	if (size == capacity) { Grow(size + 1); }
 
 	MoveData(array + index + 1, array + index, (size - index));
 	++size;
@@ -623,7 +796,7 @@ template<class Type>
 template<Unsigned I>
 inline void Vector<Type>::Insert(I index, const Vector<Type>& other)
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	MoveData(array + index + other.size, array + index, (size - index));
 	CopyData(array + index, other.array, other.size);
@@ -635,7 +808,7 @@ template<class Type>
 template<Unsigned I>
 inline void Vector<Type>::Insert(I index, Vector<Type>&& other) noexcept
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	MoveData(array + index + other.size, array + index, (size - index));
 	MoveData(array + index, other.array, other.size);
@@ -715,7 +888,7 @@ template<class Type> inline void Vector<Type>::Split(U64 index, Vector<Type>& ot
 
 template<class Type> inline void Vector<Type>::Merge(const Vector<Type>& other)
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	CopyData(array + size, other.array, other.size);
 	size += other.size;
@@ -723,7 +896,7 @@ template<class Type> inline void Vector<Type>::Merge(const Vector<Type>& other)
 
 template<class Type> inline void Vector<Type>::Merge(Vector<Type>&& other) noexcept
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	MoveData(array + size, other.array, other.size);
 	size += other.size;
@@ -733,7 +906,7 @@ template<class Type> inline void Vector<Type>::Merge(Vector<Type>&& other) noexc
 
 template<class Type> inline Vector<Type>& Vector<Type>::operator+=(const Vector<Type>& other)
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	CopyData(array + size, other.array, other.size);
 	size += other.size;
@@ -743,7 +916,7 @@ template<class Type> inline Vector<Type>& Vector<Type>::operator+=(const Vector<
 
 template<class Type> inline Vector<Type>& Vector<Type>::operator+=(Vector<Type>&& other) noexcept
 {
-	if (size + other.size > capacity) { Reserve(size + other.size); }
+	if (size + other.size > capacity) { Grow(size + other.size); }
 
 	MoveData(array + size, other.array, other.size);
 	size += other.size;
@@ -855,7 +1028,7 @@ U64 Vector<Type>::SortedInsert(Predicate predicate, const Type& value)
 	{
 		if (predicate(value, *t))
 		{
-			if (size == capacity) { Reserve(capacity + 1); }
+			if (size == capacity) { Grow(size + 1); }
 
 			MoveData(array + i + 1, array + i, (size - i));
 			Construct<Type>(array + i, value);
@@ -881,7 +1054,7 @@ U64 Vector<Type>::SortedInsert(Predicate predicate, Type&& value) noexcept
 	{
 		if (predicate(value, *t))
 		{
-			if (size == capacity) { Reserve(capacity + 1); }
+			if (size == capacity) { Grow(size + 1); }
 
 			MoveData(array + i + 1, array + i, (size - i));
 			Construct<Type>(array + i, Move(value));
@@ -901,7 +1074,357 @@ U64 Vector<Type>::SortedInsert(Predicate predicate, Type&& value) noexcept
 template<class Type>
 inline void Vector<Type>::Reserve(U64 cap)
 {
-	capacity = Memory::Reallocate(&array, cap);
+	capacity = Memory::Reallocate(&array, cap, size, tag);
+}
+
+template<class Type>
+inline void Vector<Type>::Sort()
+{
+	Sort([](const Type& a, const Type& b) { return a < b; });
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::Sort(Predicate predicate)
+{
+	if (size < 2) { return; }
+
+	//Quicksort that falls back to heapsort past 2 * log2(size) levels, so bad pivots can't make it quadratic
+	IntroSort(array, array + size, DegreeOfTwo(size) * 2, predicate);
+}
+
+template<class Type>
+inline void Vector<Type>::StableSort()
+{
+	StableSort([](const Type& a, const Type& b) { return a < b; });
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::StableSort(Predicate predicate)
+{
+	MergeSort(array, size, tag, predicate);
+}
+
+template<class Type>
+inline void Vector<Type>::RadixSort()
+{
+	RadixSort([](const Type& value) { return value; });
+}
+
+template<class Type>
+template<class KeyFunction>
+inline void Vector<Type>::RadixSort(KeyFunction key)
+{
+	LsdRadixSort(array, size, tag, key);
+}
+
+template<class Type>
+inline U64 Vector<Type>::LowerBound(const Type& value) const
+{
+	return LowerBound([](const Type& a, const Type& b) { return a < b; }, value);
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline U64 Vector<Type>::LowerBound(Predicate predicate, const Type& value) const
+{
+	U64 first = 0;
+	U64 count = size;
+
+	while (count)
+	{
+		U64 step = count / 2;
+
+		if (predicate(array[first + step], value))
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else { count = step; }
+	}
+
+	return first;
+}
+
+template<class Type>
+inline U64 Vector<Type>::UpperBound(const Type& value) const
+{
+	return UpperBound([](const Type& a, const Type& b) { return a < b; }, value);
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline U64 Vector<Type>::UpperBound(Predicate predicate, const Type& value) const
+{
+	U64 first = 0;
+	U64 count = size;
+
+	while (count)
+	{
+		U64 step = count / 2;
+
+		if (!predicate(value, array[first + step]))
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else { count = step; }
+	}
+
+	return first;
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::IntroSort(Type* first, Type* last, U64 depth, Predicate& predicate)
+{
+	while ((U64)(last - first) > SortThreshold)
+	{
+		if (depth == 0) { HeapSort(first, last, predicate); return; }
+		--depth;
+
+		//Median of three, the back ends up no less than the pivot, stopping the left scan
+		Type* middle = first + (last - first) / 2;
+		Type* back = last - 1;
+
+		if (predicate(*middle, *first)) { Swap(*middle, *first); }
+		if (predicate(*back, *middle))
+		{
+			Swap(*back, *middle);
+			if (predicate(*middle, *first)) { Swap(*middle, *first); }
+		}
+
+		Swap(*first, *middle);
+
+		Type* left = first;
+		Type* right = last;
+
+		while (true)
+		{
+			do { ++left; } while (predicate(*left, *first));
+			do { --right; } while (predicate(*first, *right));
+
+			if (left >= right) { break; }
+
+			Swap(*left, *right);
+		}
+
+		Swap(*first, *right);
+
+		//Recurse into the smaller side and loop on the larger to bound the stack
+		if (right - first < last - right)
+		{
+			IntroSort(first, right, depth, predicate);
+			first = right + 1;
+		}
+		else
+		{
+			IntroSort(right + 1, last, depth, predicate);
+			last = right;
+		}
+	}
+
+	InsertionSort(first, last, predicate);
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::InsertionSort(Type* first, Type* last, Predicate& predicate)
+{
+	if (last - first < 2) { return; }
+
+	for (Type* it = first + 1; it != last; ++it)
+	{
+		if (!predicate(*it, *(it - 1))) { continue; }
+
+		Type value = Move(*it);
+		Type* hole = it;
+
+		do
+		{
+			*hole = Move(*(hole - 1));
+			--hole;
+		} while (hole != first && predicate(value, *(hole - 1)));
+
+		*hole = Move(value);
+	}
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::HeapSort(Type* first, Type* last, Predicate& predicate)
+{
+	U64 count = last - first;
+
+	for (U64 i = count / 2; i-- > 0;) { SiftDown(first, i, count, predicate); }
+
+	for (U64 end = count - 1; end > 0; --end)
+	{
+		Swap(first[0], first[end]);
+		SiftDown(first, 0, end, predicate);
+	}
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::SiftDown(Type* first, U64 root, U64 count, Predicate& predicate)
+{
+	while (true)
+	{
+		U64 child = root * 2 + 1;
+		if (child >= count) { return; }
+
+		if (child + 1 < count && predicate(first[child], first[child + 1])) { ++child; }
+		if (!predicate(first[root], first[child])) { return; }
+
+		Swap(first[root], first[child]);
+		root = child;
+	}
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::MergeSort(Type* array, U64 size, MemoryTag tag, Predicate& predicate)
+{
+	if (size < 2) { return; }
+
+	for (U64 i = 0; i < size; i += SortThreshold)
+	{
+		InsertionSort(array + i, array + (i + SortThreshold < size ? i + SortThreshold : size), predicate);
+	}
+
+	if (size <= SortThreshold) { return; }
+
+	//Merge the runs bottom up, back and forth between array and a buffer, values are relocated like Memory::Reallocate does
+	Type* scratch = nullptr;
+	Memory::Allocate(&scratch, size, tag);
+
+	Type* src = array;
+	Type* dst = scratch;
+
+	for (U64 width = SortThreshold; width < size; width *= 2)
+	{
+		for (U64 start = 0; start < size; start += width * 2)
+		{
+			U64 middle = start + width < size ? start + width : size;
+			U64 end = start + width * 2 < size ? start + width * 2 : size;
+
+			MergeRuns(src + start, src + middle, src + end, dst + start, predicate);
+		}
+
+		Type* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if (src != array) { memcpy(array, src, sizeof(Type) * size); }
+
+	Memory::Free(&scratch);
+}
+
+template<class Type>
+template<FunctionPtr Predicate>
+inline void Vector<Type>::MergeRuns(Type* first, Type* middle, Type* last, Type* out, Predicate& predicate)
+{
+	Type* a = first;
+	Type* b = middle;
+
+	//Only take from the right run when it strictly goes first, that's what keeps the sort stable
+	while (a != middle && b != last)
+	{
+		if (predicate(*b, *a)) { memcpy(out++, b++, sizeof(Type)); }
+		else { memcpy(out++, a++, sizeof(Type)); }
+	}
+
+	if (a != middle) { memcpy(out, a, sizeof(Type) * (middle - a)); }
+	else if (b != last) { memcpy(out, b, sizeof(Type) * (last - b)); }
+}
+
+template<class Type>
+template<class KeyFunction>
+inline void Vector<Type>::LsdRadixSort(Type* array, U64 size, MemoryTag tag, KeyFunction& key)
+{
+	using Key = RemoveQualsReference<decltype(key(*array))>;
+	static_assert((IsInteger<Key> || IsFloatingPoint<Key>) && sizeof(Key) <= 8, "RadixSort Keys Must Be Integers Or Floats!");
+
+	constexpr U64 Passes = sizeof(Key);
+
+	if (size < 2) { return; }
+
+	//Histograms of every byte from a single read of the keys
+	U64 counts[Passes][256]{};
+
+	for (const Type* it = array, *end = array + size; it != end; ++it)
+	{
+		U64 bits = (U64)RadixKey(key(*it));
+		for (U64 pass = 0; pass < Passes; ++pass) { ++counts[pass][(bits >> (pass * 8)) & 0xFF]; }
+	}
+
+	Type* scratch = nullptr;
+	Memory::Allocate(&scratch, size, tag);
+
+	Type* src = array;
+	Type* dst = scratch;
+
+	for (U64 pass = 0; pass < Passes; ++pass)
+	{
+		U64* count = counts[pass];
+		U64 shift = pass * 8;
+
+		//Every key has the same byte here, the pass wouldn't move anything
+		if (count[((U64)RadixKey(key(*src)) >> shift) & 0xFF] == size) { continue; }
+
+		U64 offset = 0;
+		for (U64 i = 0; i < 256; ++i)
+		{
+			U64 bucket = count[i];
+			count[i] = offset;
+			offset += bucket;
+		}
+
+		for (Type* it = src, *end = src + size; it != end; ++it)
+		{
+			memcpy(dst + count[((U64)RadixKey(key(*it)) >> shift) & 0xFF]++, it, sizeof(Type));
+		}
+
+		Type* temp = src;
+		src = dst;
+		dst = temp;
+	}
+
+	if (src != array) { memcpy(array, src, sizeof(Type) * size); }
+
+	Memory::Free(&scratch);
+}
+
+template<class Type>
+template<class Key>
+inline constexpr auto Vector<Type>::RadixKey(Key key)
+{
+	//Maps keys to unsigned integers that sort the same way
+	if constexpr (IsFloatingPoint<Key>)
+	{
+		using Bits = Conditional<sizeof(Key) == 4, U32, U64>;
+		constexpr Bits Sign = (Bits)1 << (sizeof(Bits) * 8 - 1);
+
+		//Negative floats flip entirely so larger magnitudes go first, positive ones only need to go after them
+		Bits bits = TypePun<Bits>(key);
+		return (bits & Sign) ? (Bits)~bits : (Bits)(bits | Sign);
+	}
+	else if constexpr (IsSigned<Key>)
+	{
+		using Bits = UnsignedOf<Key>;
+		return (Bits)((Bits)key ^ ((Bits)1 << (sizeof(Key) * 8 - 1)));
+	}
+	else { return key; }
+}
+
+template<class Type>
+inline void Vector<Type>::Grow(U64 required)
+{
+	U64 grown = capacity + capacity / 2;
+	Reserve(grown > required ? grown : required);
 }
 
 template<class Type>
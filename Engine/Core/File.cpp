@@ -13,16 +13,17 @@
 static constexpr I32 READ_MODE = 0x0001;
 static constexpr I32 WRITE_MODE = 0x0002;
 static constexpr I32 READ_WRITE_MASK = 0x0003;
+static constexpr U64 STREAM_BUFFER_SIZE = Kilobytes(1);
 
 File::File()
 {
-	bufferSize = Memory::Allocate(&streamBuffer, bufferSize);
+	bufferSize = Memory::Allocate(&streamBuffer, STREAM_BUFFER_SIZE);
 	streamPtr = streamBuffer;
 }
 
 File::File(const String& path, I32 mode)
 {
-	bufferSize = Memory::Allocate(&streamBuffer, bufferSize);
+	bufferSize = Memory::Allocate(&streamBuffer, STREAM_BUFFER_SIZE);
 	streamPtr = streamBuffer;
 
 	Open(path, mode);
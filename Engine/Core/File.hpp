@@ -3,6 +3,7 @@
 #include "Defines.hpp"
 
 #include "Containers/String.hpp"
+#include "Containers/StringBuilder.hpp"
 
 enum NH_API FileOpenMode
 {
@@ -67,7 +68,7 @@ public:
 	String ReadAll();
 
 	template<class Type> U64 Write(const Type& value);
-	template<typename... Args> U64 FormatedWrite(const Args... args);
+	template<typename... Args> U64 FormatedWrite(const Args&... args);
 	U64 Write(const String& data);
 	U64 Write(const void* buffer, U64 size);
 
@@ -84,8 +85,6 @@ public:
 	static bool Exists(const String& path);
 
 private:
-	template<class Type> U64 FormatedWrite(C8* buffer, Type type);
-
 	bool Flush();
 	bool FillBuffer();
 	bool EmptyBuffer();
@@ -114,22 +113,17 @@ U64 File::Write(const Type& value)
 }
 
 template<typename... Args>
-U64 File::FormatedWrite(const Args... args)
+U64 File::FormatedWrite(const Args&... args)
 {
-	static C8 buffer[1024] = {};
+	//Kept per thread so its chunks are reused, a line goes out in one write unless it outgrew the inline buffer
+	static thread_local StringBuilder builder;
+
+	builder.Clear();
+	builder.Append(args...);
 
 	U64 count = 0;
 
-	((count += FormatedWrite(buffer + count, args)), ...);
+	builder.ForEachChunk([&](const C8* data, U64 size) { count += Write(data, size); });
 
 	return count;
-}
-
-template<class Type>
-U64 File::FormatedWrite(C8* buffer, Type type)
-{
-	if constexpr (IsStringType<Type>) { return Write(type.Data(), type.Size()); }
-	else if constexpr (IsSame<Type, StringView>) { return Write(type.Data(), type.Size()); }
-	else if constexpr (IsStringLiteral<Type>) { return Write(type, Length(type)); }
-	else { return Write(buffer, String::Format(buffer, type)); }
 }
\ No newline at end of file
@@ -87,6 +87,12 @@ static inline constexpr double F64_MIN = 2.2250738585072014e-308;			//Minimum va
 #	define NH_LITTLE_ENDIAN //Defined when on a little endian operating system
 #endif
 
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define NH_SIMD_SSE2 //Defined when SSE2 instructions are available
+#elif defined (__ARM_NEON) || defined (_M_ARM64)
+#	define NH_SIMD_NEON //Defined when NEON instructions are available
+#endif
+
 #ifdef _DEBUG
 #	define NH_DEBUG				// Defined if running in debug mode
 #	define ASSERTIONS_ENABLED	// Defined if assertions are enabled
@@ -31,6 +31,7 @@ bool Engine::Initialize(const GameInfo& _info)
 
 	if (!Logger::Initialize()) { return false; }
 	if (!Memory::Initialize()) { return false; }
+	if (!FrameArena::Initialize()) { return false; }
 	if (!Settings::Initialize()) { return false; }
 	if (!Platform::Initialize(game.name)) { return false; }
 	if (!Input::Initialize()) { return false; }
@@ -41,7 +42,12 @@ bool Engine::Initialize(const GameInfo& _info)
 	if (!Physics::Initialize()) { return false; }
 	game.componentsInit();
 	if (!World::Initialize()) { return false; }
-	if (!game.initialize()) { return false; }
+
+	{
+		MemoryTagScope memoryTag(MemoryTag::Gameplay);
+		if (!game.initialize()) { return false; }
+	}
+
 	if (!Time::Initialize()) { return false; }
 
 	Renderer::SubmitTransfer();
@@ -65,6 +71,7 @@ void Engine::Shutdown()
 	Input::Shutdown();
 	Platform::Shutdown();
 	Settings::Shutdown();
+	FrameArena::Shutdown();
 	Memory::Shutdown();
 	Logger::Shutdown();
 }
@@ -76,6 +83,8 @@ void Engine::MainLoop()
 	while (Platform::running)
 	{
 		FrameMark;
+		FrameArena::Reset();
+		Memory::Update();
 		Time::Update();
 
 		Input::Update();
@@ -83,7 +92,10 @@ void Engine::MainLoop()
 
 		if (Input::OnButtonDown(ButtonCode::Escape)) { Platform::running = false; }
 
-		game.update();
+		{
+			MemoryTagScope memoryTag(MemoryTag::Gameplay);
+			game.update();
+		}
 
 		if (!Platform::resized && !Platform::minimised)
 		{
@@ -5,8 +5,14 @@
 
 #include "Containers/String.hpp"
 
+//Based on wyhash - https://github.com/wangyi-fudan/wyhash
 class NH_API Hash
 {
+	static constexpr inline U64 secret0 = 0x2d358dccaa6c78a5ull;
+	static constexpr inline U64 secret1 = 0x8bb84b93962eacc9ull;
+	static constexpr inline U64 secret2 = 0x4b33a62ed433d4a3ull;
+	static constexpr inline U64 secret3 = 0x4d5a2da51de1aa47ull;
+
 public:
 	/// <summary>
 	/// Creates a hash for a string literal at compile-time
@@ -16,15 +22,7 @@ public:
 	/// <returns>The hash</returns>
 	static constexpr U64 String(const C8* str, U64 length)
 	{
-		U64 hash = 5381;
-		U64 i = 0;
-
-		for (i = 0; i < length; ++str, ++i)
-		{
-			hash = ((hash << 5) + hash) + (*str);
-		}
-
-		return hash;
+		return Bytes<false>(str, length);
 	}
 
 	/// <summary>
@@ -35,18 +33,7 @@ public:
 	/// <returns>The hash</returns>
 	static constexpr U64 StringCI(const C8* str, U64 length)
 	{
-		U64 hash = 5381;
-		U64 i = 0;
-
-		for (i = 0; i < length; ++str, ++i)
-		{
-			C8 c = *str;
-			if (c > 64 && c < 91) { c += 32; }
-
-			hash = ((hash << 5) + hash) + c;
-		}
-
-		return hash;
+		return Bytes<true>(str, length);
 	}
 
 	/// <summary>
@@ -57,15 +44,17 @@ public:
 	/// <returns>The hash</returns>
 	static constexpr U64 Data(const U8* data, U64 length)
 	{
-		U64 hash = 5381;
-		U64 i = 0;
-
-		for (i = 0; i < length; ++data, ++i)
-		{
-			hash = ((hash << 5) + hash) + *data;
-		}
+		return Bytes<false>(data, length);
+	}
 
-		return hash;
+	/// <summary>
+	/// Creates a hash for a single integer, a single multiply instead of the full byte hash
+	/// </summary>
+	/// <param name="value:">The integer</param>
+	/// <returns>The hash</returns>
+	static constexpr U64 Integer(U64 value)
+	{
+		return Mix(value ^ secret0, secret1);
 	}
 
 	/// <summary>
@@ -78,10 +67,128 @@ public:
 	static constexpr U64 Any(const Type& t)
 	{
 		if constexpr (IsStringType<Type> || IsSame<Type, StringView>) { return String(t.Data(), t.Size()); }
+		else if constexpr (IsInteger<Type> || IsCharacter<Type> || IsBoolean<Type> || IsEnum<Type>) { return Integer((U64)t); }
+		else if constexpr (IsPointer<Type>) { return Integer((U64)t); }
+		else if constexpr (sizeof(Type) <= 16)
+		{
+			U64 words[2]{};
+			memcpy(words, &t, sizeof(Type));
+			return Mix(words[0] ^ secret0, words[1] ^ secret1 ^ sizeof(Type));
+		}
 		else { return Data((U8*)&t, sizeof(Type)); }
 	}
 
 private:
+	static constexpr void Multiply(U64& a, U64& b)
+	{
+#if defined __SIZEOF_INT128__
+		__uint128_t r = a;
+		r *= b;
+		a = (U64)r;
+		b = (U64)(r >> 64);
+#else
+#	if defined _MSC_VER
+		if (!ConstantEvaluation()) { a = _umul128(a, b, &b); return; }
+#	endif
+		U64 ha = a >> 32, hb = b >> 32, la = (U32)a, lb = (U32)b;
+		U64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+		U64 lo = t + (rm1 << 32);
+		c += lo < t;
+		b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+		a = lo;
+#endif
+	}
+
+	static constexpr U64 Mix(U64 a, U64 b) { Multiply(a, b); return a ^ b; }
+
+	template<bool Lower, class Char>
+	static constexpr U64 Byte(Char c)
+	{
+		U64 b = (U8)c;
+		if constexpr (Lower) { if (b > 64 && b < 91) { b += 32; } }
+		return b;
+	}
+
+	/// <summary>
+	/// Reads count bytes as a little endian integer, the case insensitive reads lowercase each byte on the way
+	/// </summary>
+	template<bool Lower, U64 Count, class Char>
+	static constexpr U64 Read(const Char* data)
+	{
+#ifdef NH_LITTLE_ENDIAN
+		if constexpr (!Lower)
+		{
+			if (!ConstantEvaluation())
+			{
+				U64 value = 0;
+				memcpy(&value, data, Count);
+				return value;
+			}
+		}
+#endif
+
+		U64 value = 0;
+		for (U64 i = 0; i < Count; ++i) { value |= Byte<Lower>(data[i]) << (i * 8); }
+		return value;
+	}
+
+	template<bool Lower, class Char>
+	static constexpr U64 Bytes(const Char* data, U64 length)
+	{
+		U64 seed = Mix(secret0, secret1);
+		U64 a, b;
+
+		if (length <= 16)
+		{
+			if (length >= 4)
+			{
+				U64 offset = (length >> 3) << 2;
+				a = (Read<Lower, 4>(data) << 32) | Read<Lower, 4>(data + offset);
+				b = (Read<Lower, 4>(data + length - 4) << 32) | Read<Lower, 4>(data + length - 4 - offset);
+			}
+			else if (length > 0)
+			{
+				a = (Byte<Lower>(data[0]) << 16) | (Byte<Lower>(data[length >> 1]) << 8) | Byte<Lower>(data[length - 1]);
+				b = 0;
+			}
+			else { a = b = 0; }
+		}
+		else
+		{
+			U64 i = length;
+
+			//Three independent lanes of 16 bytes so the multiplies overlap
+			if (i >= 48)
+			{
+				U64 seed1 = seed, seed2 = seed;
+				do
+				{
+					seed = Mix(Read<Lower, 8>(data) ^ secret1, Read<Lower, 8>(data + 8) ^ seed);
+					seed1 = Mix(Read<Lower, 8>(data + 16) ^ secret2, Read<Lower, 8>(data + 24) ^ seed1);
+					seed2 = Mix(Read<Lower, 8>(data + 32) ^ secret3, Read<Lower, 8>(data + 40) ^ seed2);
+					data += 48;
+					i -= 48;
+				} while (i >= 48);
+
+				seed ^= seed1 ^ seed2;
+			}
+
+			while (i > 16)
+			{
+				seed = Mix(Read<Lower, 8>(data) ^ secret1, Read<Lower, 8>(data + 8) ^ seed);
+				data += 16;
+				i -= 16;
+			}
+
+			a = Read<Lower, 8>(data + i - 16);
+			b = Read<Lower, 8>(data + i - 8);
+		}
+
+		a ^= secret1;
+		b ^= seed;
+		Multiply(a, b);
+		return Mix(a ^ secret0 ^ length, b ^ secret1);
+	}
 
 	STATIC_CLASS(Hash);
 };
@@ -31,6 +31,7 @@ void Physics::Shutdown()
 void Physics::Update()
 {
 	ZoneScopedN("Physics");
+	MemoryTagScope memoryTag(MemoryTag::Physics);
 }
 
 U32 Physics::AddCollider(const AABB& collider)
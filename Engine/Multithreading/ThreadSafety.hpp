@@ -8,6 +8,8 @@
 
 #undef Yield
 
+static constexpr inline U64 CacheLineSize = 64;
+
 static inline void Yield() noexcept { _Thrd_yield(); }
 
 struct SpinLock
@@ -252,7 +252,7 @@ bool Input::Initialize()
 
 	joysticks.hwnd = info.window;
 	joysticks.count = Joysticks::maxXinputControllers;
-	Memory::Allocate(&joysticks.states, joysticks.count);
+	Memory::AllocateZeroed(&joysticks.states, joysticks.count);
 
 	POINT p;
 	GetCursorPos(&p);
@@ -2,132 +2,508 @@
 
 #include "Core/Logger.hpp"
 
-void MemoryRegion::Create(U8* pointer, U32 regionSize, U32 cap, U32* indices)
+#include "tracy/Tracy.hpp"
+
+#ifdef NH_PLATFORM_WINDOWS
+#include "Platform/WindowsInclude.hpp"
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#endif
+
+static constexpr U32 MagazineCapacity = 32;
+static constexpr U32 MagazineBatch = MagazineCapacity / 2;
+
+/// <summary>
+/// A per-thread stack of free slot indices for each region, refilled from and flushed to the region in batches
+/// so threads only touch a region's shared free list once every MagazineBatch allocations
+/// </summary>
+struct MemoryMagazine
+{
+	~MemoryMagazine();
+
+	U32 counts[Memory::RegionCount]{};
+	U32 indices[Memory::RegionCount][MagazineCapacity];
+
+	//Statistics this thread hasn't published yet, kept here so allocations don't touch shared counters, see Memory::Publish
+	I64 live[Memory::RegionCount]{};
+	U64 allocationCount[Memory::RegionCount]{};
+	U64 requestedBytes[Memory::RegionCount]{};
+	I64 tagBytes[MemoryTagCount]{};
+};
+
+static thread_local MemoryMagazine magazine;
+static thread_local MemoryTag currentTag = MemoryTag::General;
+static thread_local I64 sampleCountdown = 0;
+
+static void UpdatePeak(U64* peak, U64 value)
+{
+	U64 current = *peak;
+	while (value > current && SafeCompareAndExchange(peak, value, current) != current) { current = *peak; }
+}
+
+MemoryMagazine::~MemoryMagazine()
+{
+	if (!Memory::memory) { return; }
+
+	for (U32 i = 0; i < Memory::RegionCount; ++i)
+	{
+		if (counts[i]) { Memory::regions[i].Flush(indices[i], counts[i]); counts[i] = 0; }
+	}
+
+	Memory::Publish();
+}
+
+void MemoryRegion::Create(U8* pointer, U32 regionSize, U32 cap, U32* indices, MemoryTag* tags)
 {
 	capacity = cap;
 	region = pointer;
 	freeIndices = indices;
-	freeIndices = indices;
+	this->tags = tags;
 	this->regionSize = regionSize;
+
+	//Regions with few slots skip the magazines so a handful of threads can't hoard all of them
+	cached = cap >= MagazineCapacity * 64;
 }
 
-bool MemoryRegion::Allocate(void** pointer)
+bool MemoryRegion::Allocate(void** pointer, U64 size, MemoryTag tag)
 {
-	if (Full()) { return false; }
-
 	U32 index = GetFree();
-	*pointer = region + index * regionSize;
+	if (index == U32_MAX)
+	{
+		if (SafeIncrement(&spills) == 1) { Logger::Warn("Memory Region Of ", regionSize, " Bytes Is Full, Spilling Into Larger Slots!"); }
+		return false;
+	}
+
+	U32 id = (U32)(this - Memory::regions);
+	++magazine.live[id];
+	++magazine.allocationCount[id];
+	magazine.requestedBytes[id] += size;
+	magazine.tagBytes[(U8)tag] += regionSize;
+
+	tags[index] = tag;
+
+	*pointer = region + (U64)index * regionSize;
 	return true;
 }
 
-bool MemoryRegion::Reallocate(void** src, void** dst)
+void MemoryRegion::Free(void** pointer)
+{
+#ifdef NH_DEBUG
+	memset(*pointer, Memory::FreedPattern, regionSize);
+#endif
+
+	U32 index = (U32)(((U8*)*pointer - region) / regionSize);
+	--magazine.live[this - Memory::regions];
+	magazine.tagBytes[(U8)tags[index]] -= regionSize;
+	Release(index);
+	*pointer = nullptr;
+}
+
+MemoryTag MemoryRegion::Tag(void* pointer)
+{
+	return tags[((U8*)pointer - region) / regionSize];
+}
+
+bool MemoryRegion::WithinRegion(void* pointer)
 {
-	if (Memory::region1kb.WithinRegion(*src))
+	return pointer >= region && pointer < region + (U64)capacity * regionSize;
+}
+
+U32 MemoryRegion::GetFree()
+{
+	U32 index;
+
+	if (!cached)
+	{
+		Publish();
+		if (Acquire(&index, 1)) { return index; }
+		return U32_MAX;
+	}
+
+	U32 id = (U32)(this - Memory::regions);
+	U32& count = magazine.counts[id];
+	U32* cache = magazine.indices[id];
+
+	if (count == 0)
+	{
+		Publish();
+		count = Acquire(cache, MagazineBatch);
+		if (count == 0) { return U32_MAX; }
+	}
+
+	return cache[--count];
+}
+
+void MemoryRegion::Release(U32 index)
+{
+	if (!cached) { Flush(&index, 1); Publish(); return; }
+
+	U32 id = (U32)(this - Memory::regions);
+	U32& count = magazine.counts[id];
+	U32* cache = magazine.indices[id];
+
+	if (count == MagazineCapacity)
+	{
+		Publish();
+		count -= MagazineBatch;
+		Flush(cache + count, MagazineBatch);
+	}
+
+	cache[count++] = index;
+}
+
+void MemoryRegion::Publish()
+{
+	U32 id = (U32)(this - Memory::regions);
+
+	I64& liveDelta = magazine.live[id];
+	if (liveDelta)
 	{
-		if (this == &Memory::region1kb) { return false; }
+		//Another thread can publish a free before the allocation it frees, live dips below zero until then
+		I64 current = (I64)SafeAdd(&live, liveDelta);
+		if (liveDelta > 0 && current > 0) { UpdatePeak(&peak, (U64)current); }
+		liveDelta = 0;
+	}
 
-		Allocate(dst);
-		memmove(*dst, *src, sizeof(Region1kb));
-		Memory::region1kb.Free(src);
+	if (magazine.allocationCount[id])
+	{
+		SafeAdd(&allocationCount, magazine.allocationCount[id]);
+		SafeAdd(&requestedBytes, magazine.requestedBytes[id]);
+		magazine.allocationCount[id] = 0;
+		magazine.requestedBytes[id] = 0;
 	}
-	else if (Memory::region16kb.WithinRegion(*src))
+
+	for (U32 i = 0; i < MemoryTagCount; ++i)
 	{
-		if (this == &Memory::region16kb) { return false; }
+		if (magazine.tagBytes[i]) { Memory::Track((MemoryTag)i, magazine.tagBytes[i]); magazine.tagBytes[i] = 0; }
+	}
+}
+
+U32 MemoryRegion::Acquire(U32* indices, U32 count)
+{
+	LockGuard lockGuard(lock);
+
+	U32 acquired = 0;
 
-		Allocate(dst);
-		memmove(*dst, *src, sizeof(Region16kb));
-		Memory::region16kb.Free(src);
+	while (acquired < count && freeCount) { indices[acquired++] = freeIndices[--freeCount]; }
+
+	U32 fresh = count - acquired;
+	if (fresh > capacity - lastFree) { fresh = capacity - lastFree; }
+
+	if (fresh && Commit(lastFree + fresh))
+	{
+		while (fresh--) { indices[acquired++] = lastFree++; }
 	}
-	else if (Memory::region256kb.WithinRegion(*src))
+
+	return acquired;
+}
+
+bool MemoryRegion::Commit(U32 slotCount)
+{
+	U64 needed = (U64)slotCount * regionSize;
+
+	if (needed > committed)
 	{
-		if (this == &Memory::region256kb) { return false; }
+		U64 size = NextMultipleOf(needed - committed, Memory::CommitGranularity);
+		U64 remaining = (U64)capacity * regionSize - committed;
+		if (size > remaining) { size = remaining; }
 
-		Allocate(dst);
-		memmove(*dst, *src, sizeof(Region256kb));
-		Memory::region256kb.Free(src);
+		if (!Memory::CommitPages(region + committed, size)) { return false; }
+		committed += size;
 	}
-	else if (Memory::region4mb.WithinRegion(*src))
+
+	needed = (U64)slotCount * sizeof(U32);
+
+	if (needed > committedIndices)
 	{
-		if (this == &Memory::region4mb) { return false; }
+		U64 size = NextMultipleOf(needed - committedIndices, Memory::CommitGranularity);
+		U64 remaining = (U64)capacity * sizeof(U32) - committedIndices;
+		if (size > remaining) { size = remaining; }
 
-		Allocate(dst);
-		memmove(*dst, *src, sizeof(Region4mb));
-		Memory::region4mb.Free(src);
+		if (!Memory::CommitPages((U8*)freeIndices + committedIndices, size)) { return false; }
+		committedIndices += size;
 	}
 
-	*src = *dst;
+	needed = (U64)slotCount * sizeof(MemoryTag);
+
+	if (needed > committedTags)
+	{
+		U64 size = NextMultipleOf(needed - committedTags, Memory::CommitGranularity);
+		U64 remaining = (U64)capacity * sizeof(MemoryTag) - committedTags;
+		if (size > remaining) { size = remaining; }
+
+		if (!Memory::CommitPages((U8*)tags + committedTags, size)) { return false; }
+		committedTags += size;
+	}
 
 	return true;
 }
 
-void MemoryRegion::Free(void** pointer)
+void MemoryRegion::Flush(const U32* indices, U32 count)
 {
-	memset(*pointer, 0, regionSize);
+	LockGuard lockGuard(lock);
 
-	U32 index = (U32)(((U8*)*pointer - region) / regionSize);
-	Release(index);
-	*pointer = nullptr;
+	memcpy(freeIndices + freeCount, indices, count * sizeof(U32));
+	freeCount += count;
 }
 
-bool MemoryRegion::WithinRegion(void* pointer)
+U32 Memory::allocations = 0;
+U8* Memory::memory = nullptr;
+U64 Memory::arenaSize = DynamicMemorySize;
+
+MemoryRegion Memory::regions[RegionCount];
+
+bool Memory::initialized = false;
+
+U64 Memory::largePageSize = 0;
+U64 Memory::largeAllocations = 0;
+U64 Memory::largeBytes = 0;
+U64 Memory::largePeakBytes = 0;
+U64 Memory::largeHugePageBytes = 0;
+U64 Memory::overflowAllocations = 0;
+
+MemoryTagStats Memory::tagStats[MemoryTagCount];
+bool Memory::breakOnBudget[MemoryTagCount];
+
+MemorySampling Memory::samplingMode = MemorySampling::Off;
+U64 Memory::samplingInterval = 0;
+U64 Memory::frameSamples = 0;
+U64 Memory::frameSampledBytes = 0;
+
+//Sits in front of every large allocation
+struct LargeAllocation
 {
-	return pointer > region && pointer < region + capacity * regionSize;
-}
+	U64 size;		//Usable bytes after the header
+	U64 mapped;		//Bytes backed by memory, including the header
+	U64 reserved;	//Address space owned, growing within it doesn't move the allocation
+	bool hugePages;
+	MemoryTag tag;
+};
 
-U32 MemoryRegion::GetFree()
+static constexpr U32 RegionSizes[]{
+	sizeof(Region16b), sizeof(Region32b), sizeof(Region64b), sizeof(Region128b), sizeof(Region256b), sizeof(Region512b),
+	sizeof(Region1kb), sizeof(Region16kb), sizeof(Region256kb), sizeof(Region4mb)
+};
+
+/// <summary>
+/// Per size class demand recorded over previous sessions, stored next to the executable and used to carve the arena at startup
+/// </summary>
+struct MemoryProfile
+{
+	static constexpr U32 Magic = 0x504D484E; //NHMP
+	static constexpr U32 Version = 1;
+
+	U32 magic = Magic;
+	U32 version = Version;
+	U64 arenaSize = 0;					//Overrides MEMORY_SIZE when not zero, kept as is between sessions
+	U64 demand[RegionSizeCount]{};		//Slots needed at once, peak live slots plus spills
+};
+
+static MemoryProfile profile;
+
+static bool ProfilePath(C8* path, U32 capacity)
 {
-	U32 index = ThreadSafety::SafeDecrement32((L32*)&freeCount);
+#ifdef NH_PLATFORM_WINDOWS
+	U32 length = GetModuleFileNameA(nullptr, path, capacity);
+#else
+	I64 linkLength = readlink("/proc/self/exe", path, capacity - 1);
+	U32 length = linkLength > 0 ? (U32)linkLength : 0;
+#endif
 
-	if (index < capacity) { return freeIndices[index]; }
+	if (length == 0 || length >= capacity) { return false; }
 
-	++freeCount;
-	return ThreadSafety::SafeIncrement32((L32*)&lastFree) - 1;
+	while (length && path[length - 1] != '\\' && path[length - 1] != '/') { --length; }
+
+	constexpr C8 FileName[] = "Memory.profile";
+	if (length + sizeof(FileName) > capacity) { return false; }
+
+	memcpy(path + length, FileName, sizeof(FileName));
+	return true;
 }
 
-void MemoryRegion::Release(U32 index)
+static bool ReadProfile()
 {
-	freeIndices[ThreadSafety::SafeIncrement32((L32*)&freeCount) - 1] = index;
+	C8 path[512];
+	if (!ProfilePath(path, sizeof(path))) { return false; }
+
+	MemoryProfile stored{};
+	bool success = false;
+
+#ifdef NH_PLATFORM_WINDOWS
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return false; }
+
+	DWORD bytesRead = 0;
+	success = ReadFile(file, &stored, sizeof(MemoryProfile), &bytesRead, nullptr) && bytesRead == sizeof(MemoryProfile);
+	CloseHandle(file);
+#else
+	I32 file = open(path, O_RDONLY);
+	if (file < 0) { return false; }
+
+	success = read(file, &stored, sizeof(MemoryProfile)) == sizeof(MemoryProfile);
+	close(file);
+#endif
+
+	if (!success || stored.magic != MemoryProfile::Magic || stored.version != MemoryProfile::Version) { return false; }
+
+	profile = stored;
+	return true;
 }
 
-bool MemoryRegion::Full()
+static void WriteProfile()
 {
-	return lastFree >= capacity && freeCount == 0;
+	C8 path[512];
+	if (!ProfilePath(path, sizeof(path))) { return; }
+
+#ifdef NH_PLATFORM_WINDOWS
+	HANDLE file = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) { return; }
+
+	DWORD bytesWritten = 0;
+	WriteFile(file, &profile, sizeof(MemoryProfile), &bytesWritten, nullptr);
+	CloseHandle(file);
+#else
+	I32 file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (file < 0) { return; }
+
+	write(file, &profile, sizeof(MemoryProfile));
+	close(file);
+#endif
 }
 
-U32 Memory::allocations = 0;
-U8* Memory::memory = nullptr;
+//NH_MEMORY_SIZE in megabytes, zero if it isn't set
+static U64 EnvironmentMemorySize()
+{
+	C8 value[32]{};
 
-MemoryRegion Memory::region1kb;
-MemoryRegion Memory::region16kb;
-MemoryRegion Memory::region256kb;
-MemoryRegion Memory::region4mb;
+#ifdef NH_PLATFORM_WINDOWS
+	U32 length = GetEnvironmentVariableA("NH_MEMORY_SIZE", value, sizeof(value));
+	if (length == 0 || length >= sizeof(value)) { return 0; }
+#else
+	const C8* variable = getenv("NH_MEMORY_SIZE");
+	if (!variable) { return 0; }
+	strncpy(value, variable, sizeof(value) - 1);
+#endif
 
-bool Memory::initialized = false;
+	U64 megabytes = 0;
+	for (const C8* c = value; *c >= '0' && *c <= '9'; ++c) { megabytes = megabytes * 10 + (*c - '0'); }
+
+	return Megabytes(megabytes);
+}
 
 bool Memory::Initialize()
 {
 	if (!ThreadSafety::SafeCheckAndSet32((volatile L32*)&initialized, 0))
 	{
-		U64 maxKilobytes = DynamicMemorySize / 1024;
+		bool profiled = ReadProfile();
+
+		arenaSize = DynamicMemorySize;
+		if (profiled && profile.arenaSize) { arenaSize = profile.arenaSize; }
+
+		U64 environmentSize = EnvironmentMemorySize();
+		if (environmentSize) { arenaSize = environmentSize; }
+
+		//Whole 4mb slots keep the layout below aligned
+		arenaSize = NextMultipleOf(arenaSize, sizeof(Region4mb));
+
+		U64 maxKilobytes = arenaSize / 1024;
+
+		U32 counts[RegionCount];
+
+		//Each small size class gets an equal share of the arena, 12% in total
+		U64 smallRegionBytes = (U64)(arenaSize * 0.02f);
+		U64 smallBytes = 0;
+		for (U32 i = 0; i < SmallRegionCount; ++i)
+		{
+			counts[i] = U32(smallRegionBytes / RegionSizes[i]);
+			smallBytes += (U64)counts[i] * RegionSizes[i];
+		}
 
 		U32 region4mbCount = U32(maxKilobytes / 81920);
 		U32 region256kbCount = U32(maxKilobytes * 0.15f) / 256;
 		U32 region16kbCount = U32(maxKilobytes * 0.3f) / 16;
-		U32 region1kbCount = U32(maxKilobytes - (region16kbCount * 16) - (region256kbCount * 256) - (region4mbCount * 4096));
+		U32 region1kbCount = U32(maxKilobytes - (region16kbCount * 16) - (region256kbCount * 256) - (region4mbCount * 4096) - (smallBytes + 1023) / 1024);
+
+		counts[SmallRegionCount] = region1kbCount;
+		counts[SmallRegionCount + 1] = region16kbCount;
+		counts[SmallRegionCount + 2] = region256kbCount;
+		counts[SmallRegionCount + 3] = region4mbCount;
+
+		//Give each size class what it needed last time with some headroom, what's left is split like the defaults above
+		if (profiled)
+		{
+			U64 wanted[RegionCount];
+			U64 wantedBytes = 0;
+
+			for (U32 i = 0; i < RegionCount; ++i)
+			{
+				U64 minimum = CommitGranularity / RegionSizes[i];
+				wanted[i] = profile.demand[i] + profile.demand[i] / 4;
+				if (wanted[i] < minimum) { wanted[i] = minimum ? minimum : 1; }
+
+				wantedBytes += wanted[i] * RegionSizes[i];
+			}
+
+			F64 scale = wantedBytes > arenaSize ? (F64)arenaSize / wantedBytes : 1.0;
+			F64 leftover = wantedBytes < arenaSize ? (F64)(arenaSize - wantedBytes) / arenaSize : 0.0;
+
+			U64 scaledBytes = 0;
+			for (U32 i = 0; i < RegionCount; ++i)
+			{
+				counts[i] = U32(wanted[i] * scale + counts[i] * leftover);
+				scaledBytes += (U64)counts[i] * RegionSizes[i];
+			}
+
+			//Floating point rounding can leave the classes a few slots over the arena, take them back from the smallest ones
+			for (U32 i = 0; i < RegionCount && scaledBytes > arenaSize; ++i)
+			{
+				U64 excess = (scaledBytes - arenaSize + RegionSizes[i] - 1) / RegionSizes[i];
+				if (excess > counts[i]) { excess = counts[i]; }
+
+				counts[i] -= (U32)excess;
+				scaledBytes -= excess * RegionSizes[i];
+			}
+		}
+
+		U64 slotCount = 0;
+		U64 regionBytes = 0;
+		for (U32 i = 0; i < RegionCount; ++i)
+		{
+			slotCount += counts[i];
+			regionBytes += (U64)counts[i] * RegionSizes[i];
+		}
 
-		U32 freeListMemory = (region4mbCount + region256kbCount + region16kbCount + region1kbCount) * sizeof(U32);
+		//Slots past arenaSize would overlap the free lists and fail IsAllocated
+		ASSERT(regionBytes <= arenaSize);
 
-		memory = (U8*)_aligned_malloc(DynamicMemorySize + freeListMemory, 32);
+		U64 freeListMemory = slotCount * sizeof(U32);
+		U64 tagMemory = slotCount * sizeof(MemoryTag);
+
+		//Only address space is reserved here, pages are committed as each region first hands them out and start zeroed
+		memory = ReservePages(arenaSize + freeListMemory + tagMemory);
 		if (!memory) { return initialized = false; }
 
-		memset(memory, 0, DynamicMemorySize + freeListMemory);
+		//Regions are laid out largest first so every slot is aligned to its own size relative to memory
+		U8* pointer = memory;
+		U32* freeLists = (U32*)(memory + arenaSize);
+		MemoryTag* tags = (MemoryTag*)(memory + arenaSize + freeListMemory);
 
-		U32* freeLists = (U32*)(memory + DynamicMemorySize);
+		for (I32 i = RegionCount - 1; i >= 0; --i)
+		{
+			regions[i].Create(pointer, RegionSizes[i], counts[i], freeLists, tags);
+			pointer += (U64)counts[i] * RegionSizes[i];
+			freeLists += counts[i];
+			tags += counts[i];
+		}
 
-		region1kb.Create(memory, sizeof(Region1kb), region1kbCount, freeLists);
-		region16kb.Create(region1kb.region + region1kbCount * sizeof(Region1kb), sizeof(Region16kb), region16kbCount, region1kb.freeIndices + region1kb.capacity);
-		region256kb.Create(region16kb.region + region16kbCount * sizeof(Region16kb), sizeof(Region256kb), region256kbCount, region16kb.freeIndices + region16kb.capacity);
-		region4mb.Create(region256kb.region + region256kbCount * sizeof(Region256kb), sizeof(Region4mb), region4mbCount, region256kb.freeIndices + region256kb.capacity);
+#if defined NH_PLATFORM_WINDOWS
+		largePageSize = GetLargePageMinimum();
+#elif defined MAP_HUGETLB
+		largePageSize = Megabytes(2);
+#endif
 	}
 
 	return true;
@@ -137,50 +513,520 @@ void Memory::Shutdown()
 {
 	Logger::Trace("Cleaning Up Memory...");
 
+	Publish();
+
+	//Demand from older sessions fades out slowly so one unusual session doesn't shrink a class straight away
+	for (U32 i = 0; i < RegionCount; ++i)
+	{
+		U64 demand = regions[i].peak + regions[i].spills;
+		U64 previous = profile.demand[i] - profile.demand[i] / 4;
+		profile.demand[i] = demand > previous ? demand : previous;
+	}
+
+	WriteProfile();
+
 	initialized = false;
 }
 
-U64 Memory::AllocateInternal(void** pointer, U64 size, U64 typeSize)
+void Memory::Update()
+{
+	Publish();
+
+#ifdef TRACY_ENABLE
+	static constexpr const C8* LivePlots[RegionCount]{
+		"Memory 16b", "Memory 32b", "Memory 64b", "Memory 128b", "Memory 256b",
+		"Memory 512b", "Memory 1kb", "Memory 16kb", "Memory 256kb", "Memory 4mb"
+	};
+
+	static constexpr const C8* FragmentationPlots[RegionCount]{
+		"Fragmentation 16b", "Fragmentation 32b", "Fragmentation 64b", "Fragmentation 128b", "Fragmentation 256b",
+		"Fragmentation 512b", "Fragmentation 1kb", "Fragmentation 16kb", "Fragmentation 256kb", "Fragmentation 4mb"
+	};
+
+	for (U32 i = 0; i < RegionCount; ++i)
+	{
+		const MemoryRegion& region = regions[i];
+		TracyPlot(LivePlots[i], (I64)region.live);
+
+		U64 reserved = region.allocationCount * region.regionSize;
+		TracyPlot(FragmentationPlots[i], reserved ? 1.0 - (F64)region.requestedBytes / reserved : 0.0);
+	}
+
+	TracyPlot("Memory Large", (I64)largeBytes);
+
+	static constexpr const C8* TagPlots[MemoryTagCount]{
+		"Memory General", "Memory Renderer", "Memory Resources", "Memory Audio", "Memory UI", "Memory Physics", "Memory Gameplay"
+	};
+
+	for (U32 i = 0; i < MemoryTagCount; ++i) { TracyPlot(TagPlots[i], (I64)tagStats[i].live); }
+
+	if (samplingMode != MemorySampling::Off)
+	{
+		U64 samples = frameSamples;
+		U64 bytes = frameSampledBytes;
+		SafeSubtract(&frameSamples, samples);
+		SafeSubtract(&frameSampledBytes, bytes);
+
+		TracyPlot("Sampled Allocations", (I64)samples);
+		TracyPlot("Sampled Bytes", (I64)bytes);
+	}
+#endif
+}
+
+void Memory::Publish()
 {
-	if (size <= sizeof(Region1kb)) { region1kb.Allocate((void**)pointer); return sizeof(Region1kb) / typeSize; }
-	else if (size <= sizeof(Region16kb)) { region16kb.Allocate((void**)pointer); return sizeof(Region16kb) / typeSize; }
-	else if (size <= sizeof(Region256kb)) { region256kb.Allocate((void**)pointer); return sizeof(Region256kb) / typeSize; }
-	else if (size <= sizeof(Region4mb)) { region4mb.Allocate((void**)pointer); return sizeof(Region4mb) / typeSize; }
-	else { *pointer = malloc(size); return size / typeSize; }
+	for (MemoryRegion& region : regions) { region.Publish(); }
+}
 
-	return 0;
+void Memory::SetSampling(MemorySampling mode, U64 interval)
+{
+	samplingInterval = interval ? interval : 1;
+	samplingMode = mode;
 }
 
-U64 Memory::ReallocateInternal(void** src, void** dst, U64 size, U64 typeSize)
+void Memory::Sample(void* pointer, U64 size)
 {
-	if (size <= sizeof(Region1kb)) { region1kb.Reallocate(src, dst); return sizeof(Region1kb) / typeSize; }
-	else if (size <= sizeof(Region16kb)) { region16kb.Reallocate(src, dst); return sizeof(Region16kb) / typeSize; }
-	else if (size <= sizeof(Region256kb)) { region256kb.Reallocate(src, dst); return sizeof(Region256kb) / typeSize; }
-	else if (size <= sizeof(Region4mb)) { region4mb.Reallocate(src, dst); return sizeof(Region4mb) / typeSize; }
-	else { *dst = realloc(*src, size); return size / typeSize; }
+	sampleCountdown -= samplingMode == MemorySampling::Bytes ? (I64)size : 1;
+	if (sampleCountdown > 0) { return; }
+
+	sampleCountdown += samplingInterval;
+	if (sampleCountdown <= 0) { sampleCountdown = samplingInterval; }
+
+	SafeIncrement(&frameSamples);
+	SafeAdd(&frameSampledBytes, size);
 
-	return 0;
+	//Freed straight away, only the callstack matters and the pool's live size stays at zero
+	TracyAllocNS(pointer, size, SampleDepth, "Sampled Allocations");
+	TracyFreeN(pointer, "Sampled Allocations");
+}
+
+void Memory::SetBudget(MemoryTag tag, U64 bytes, bool breakOnExceed)
+{
+	tagStats[(U8)tag].budget = bytes;
+	breakOnBudget[(U8)tag] = breakOnExceed;
+}
+
+MemoryTag Memory::SetTag(MemoryTag tag)
+{
+	MemoryTag previous = currentTag;
+	currentTag = tag;
+	return previous;
+}
+
+void Memory::Track(MemoryTag tag, I64 bytes)
+{
+	MemoryTagStats& stats = tagStats[(U8)tag];
+	U64 live = SafeAdd(&stats.live, bytes);
+
+	//Frees published ahead of their allocations leave live briefly below zero, see MemoryRegion::Publish
+	if (bytes <= 0 || (I64)live < 0) { return; }
+
+	UpdatePeak(&stats.peak, live);
+
+	//Only report crossing the budget, not every allocation over it
+	U64 budget = stats.budget;
+	if (budget && live > budget && live - bytes <= budget)
+	{
+		Logger::Warn("Memory Budget Exceeded For Tag ", (U32)tag, ", ", live, " / ", budget, " Bytes!");
+#ifdef NH_DEBUG
+		if (breakOnBudget[(U8)tag]) { BreakPoint; }
+#endif
+	}
+}
+
+U64 Memory::AllocateInternal(void** pointer, U64 size, U64 typeSize, MemoryTag tag)
+{
+	U64 capacity = AllocateSlot(pointer, size, tag);
+
+	if (samplingMode != MemorySampling::Off && *pointer) { Sample(*pointer, size); }
+
+	return capacity / typeSize;
+}
+
+U64 Memory::AllocateSlot(void** pointer, U64 size, MemoryTag tag)
+{
+	if (tag == MemoryTag::Current) { tag = currentTag; }
+
+	if (size <= sizeof(Region4mb))
+	{
+		//A full size class spills into the next bigger one, bigger slots are still aligned for it
+		for (U32 i = RegionIndex(size); i < RegionCount; ++i)
+		{
+			MemoryRegion& region = regions[i];
+			if (region.Allocate(pointer, size, tag)) { return region.regionSize; }
+		}
+
+		//Every region that fits is full, map fresh pages so the session keeps running
+		if (SafeIncrement(&overflowAllocations) == 1) { Logger::Error("Memory Regions Are Exhausted, Consider Increasing MEMORY_SIZE!"); }
+	}
+
+	return AllocateLarge(pointer, size, tag);
+}
+
+U64 Memory::AllocateAlignedInternal(void** pointer, U64 size, U64 typeSize, U64 alignment, MemoryTag tag)
+{
+	if (alignment == 0 || alignment > MaxAlignment || (alignment & (alignment - 1)))
+	{
+		Logger::Error("Unsupported Alignment: ", alignment, "!");
+		*pointer = nullptr;
+		return 0;
+	}
+
+	//Every slot is aligned to its own size, so a slot at least as big as the alignment is aligned to it
+	return AllocateInternal(pointer, size < alignment ? alignment : size, typeSize, tag);
+}
+
+U64 Memory::ReallocateInternal(void** pointer, U64 size, U64 liveSize, U64 typeSize)
+{
+	if (FrameArena::Contains(*pointer))
+	{
+		void* dst = FrameArena::ReallocateInternal(*pointer, size, liveSize);
+		if (dst) { *pointer = dst; return FrameArena::AllocationSize(dst) / typeSize; }
+
+		//The frame arena is full, move to the regular regions
+		void* src = *pointer;
+		U64 oldSize = FrameArena::AllocationSize(src);
+
+		*pointer = nullptr;
+		U64 capacity = AllocateInternal(pointer, size, typeSize, MemoryTag::Current);
+		if (*pointer) { memcpy(*pointer, src, liveSize < oldSize ? liveSize : oldSize); }
+
+		return capacity;
+	}
+
+	if (!IsAllocated(*pointer)) { return ReallocateLarge(pointer, size, liveSize) / typeSize; }
+
+	MemoryRegion* source = GetRegion(*pointer);
+
+	if (source == nullptr) { return 0; }
+
+	//Still fits, nothing to move
+	if (size <= source->regionSize) { return source->regionSize / typeSize; }
+
+	if (liveSize > source->regionSize) { liveSize = source->regionSize; }
+
+	void* dst = nullptr;
+	U64 newSize = AllocateSlot(&dst, size, source->Tag(*pointer));
+
+	if (dst == nullptr) { return source->regionSize / typeSize; }
+
+	if (samplingMode != MemorySampling::Off) { Sample(dst, size); }
+
+	memcpy(dst, *pointer, liveSize);
+	source->Free(pointer);
+	*pointer = dst;
+
+	return newSize / typeSize;
 }
 
 void Memory::FreeInternal(void** pointer)
 {
-	if (!IsAllocated(*pointer)) { free(*pointer); return; }
+	if (FrameArena::Contains(*pointer)) { *pointer = nullptr; return; }
+
+	if (!IsAllocated(*pointer)) { FreeLarge(pointer); return; }
+
+	MemoryRegion* region = GetRegion(*pointer);
+	if (region) { region->Free(pointer); }
+}
+
+U64 Memory::AllocateLarge(void** pointer, U64 size, MemoryTag tag)
+{
+	U64 total = size + LargeHeaderSize;
+	U8* base = nullptr;
+	U64 mapped = 0;
+	U64 reserved = 0;
+	bool hugePages = false;
+
+	U64 pageSize = largePageSize;
+	if (pageSize && total >= pageSize)
+	{
+		mapped = NextMultipleOf(total, pageSize);
+
+#if defined NH_PLATFORM_WINDOWS
+		base = (U8*)VirtualAlloc(nullptr, mapped, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+#elif defined MAP_HUGETLB
+		void* map = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		base = map == MAP_FAILED ? nullptr : (U8*)map;
+#endif
+
+		//Needs the lock pages privilege on Windows and a configured huge page pool on Linux, don't keep asking
+		if (base) { reserved = mapped; hugePages = true; }
+		else { largePageSize = 0; }
+	}
+
+	if (!base)
+	{
+		mapped = NextMultipleOf(total, MaxAlignment);
+
+#ifdef NH_PLATFORM_WINDOWS
+		//Reserve headroom so growing only has to commit more pages
+		reserved = NextMultipleOf(mapped * 2, CommitGranularity);
+#else
+		reserved = mapped;
+#endif
+
+		base = ReservePages(reserved);
+		if (base && !CommitPages(base, mapped)) { ReleasePages(base, reserved); base = nullptr; }
 
-	if (region1kb.WithinRegion(*pointer)) { region1kb.Free(pointer); }
-	else if (region16kb.WithinRegion(*pointer)) { region16kb.Free(pointer); }
-	else if (region256kb.WithinRegion(*pointer)) { region256kb.Free(pointer); }
-	else if (region4mb.WithinRegion(*pointer)) { region4mb.Free(pointer); }
+#ifdef MADV_HUGEPAGE
+		if (base) { madvise(base, mapped, MADV_HUGEPAGE); }
+#endif
+	}
+
+	if (!base) { Logger::Error("Failed To Map Large Allocation Of ", size, " Bytes!"); *pointer = nullptr; return 0; }
+
+	LargeAllocation* header = (LargeAllocation*)base;
+	header->size = mapped - LargeHeaderSize;
+	header->mapped = mapped;
+	header->reserved = reserved;
+	header->hugePages = hugePages;
+	header->tag = tag;
+
+	Track(tag, mapped);
+
+	SafeIncrement(&largeAllocations);
+	U64 bytes = SafeAdd(&largeBytes, mapped);
+	if (hugePages) { SafeAdd(&largeHugePageBytes, mapped); }
+
+	UpdatePeak(&largePeakBytes, bytes);
+
+	*pointer = base + LargeHeaderSize;
+	return header->size;
+}
+
+U64 Memory::ReallocateLarge(void** pointer, U64 size, U64 liveSize)
+{
+	U8* base = (U8*)*pointer - LargeHeaderSize;
+	LargeAllocation* header = (LargeAllocation*)base;
+
+	if (size <= header->size) { return header->size; }
+
+	U64 mapped = NextMultipleOf(size + LargeHeaderSize, MaxAlignment);
+
+	if (!header->hugePages)
+	{
+#ifdef NH_PLATFORM_WINDOWS
+		//Grow in place by committing more of the reservation
+		if (mapped <= header->reserved && CommitPages(base + header->mapped, mapped - header->mapped))
+		{
+			SafeAdd(&largeBytes, mapped - header->mapped);
+			Track(header->tag, mapped - header->mapped);
+			header->mapped = mapped;
+			header->size = mapped - LargeHeaderSize;
+			return header->size;
+		}
+#elif defined MREMAP_MAYMOVE
+		//The kernel moves the page tables instead of copying
+		void* map = mremap(base, header->mapped, mapped, MREMAP_MAYMOVE);
+		if (map != MAP_FAILED)
+		{
+			header = (LargeAllocation*)map;
+			SafeAdd(&largeBytes, mapped - header->mapped);
+			Track(header->tag, mapped - header->mapped);
+			header->mapped = mapped;
+			header->reserved = mapped;
+			header->size = mapped - LargeHeaderSize;
+			*pointer = (U8*)map + LargeHeaderSize;
+			return header->size;
+		}
+#endif
+	}
+
+	void* dst = nullptr;
+	U64 newSize = AllocateLarge(&dst, size, header->tag);
+	if (dst == nullptr) { return header->size; }
+
+	memcpy(dst, *pointer, liveSize < header->size ? liveSize : header->size);
+	FreeLarge(pointer);
+	*pointer = dst;
+
+	return newSize;
+}
+
+void Memory::FreeLarge(void** pointer)
+{
+	if (*pointer == nullptr) { return; }
+
+	U8* base = (U8*)*pointer - LargeHeaderSize;
+	LargeAllocation* header = (LargeAllocation*)base;
+
+	SafeDecrement(&largeAllocations);
+	SafeSubtract(&largeBytes, header->mapped);
+	Track(header->tag, -(I64)header->mapped);
+	if (header->hugePages) { SafeSubtract(&largeHugePageBytes, header->mapped); }
+
+	ReleasePages(base, header->reserved);
+	*pointer = nullptr;
+}
+
+U32 Memory::RegionIndex(U64 size)
+{
+	if (size <= sizeof(Region16b)) { return 0; }
+	if (size <= sizeof(Region1kb)) { return (U32)DegreeOfTwo(BitCeiling(size)) - 4; }
+	if (size <= sizeof(Region16kb)) { return SmallRegionCount + 1; }
+	if (size <= sizeof(Region256kb)) { return SmallRegionCount + 2; }
+	return SmallRegionCount + 3;
+}
+
+MemoryRegion* Memory::GetRegion(void* pointer)
+{
+	for (MemoryRegion& region : regions)
+	{
+		if (region.WithinRegion(pointer)) { return &region; }
+	}
+
+	return nullptr;
 }
 
 bool Memory::IsAllocated(void* pointer)
 {
-	return pointer != nullptr && pointer >= memory && pointer < memory + DynamicMemorySize;
+	return pointer != nullptr && pointer >= memory && pointer < memory + arenaSize;
+}
+
+MemoryStats Memory::Statistics()
+{
+	MemoryStats stats{};
+
+	Publish();
+
+	for (U32 i = 0; i < RegionCount; ++i)
+	{
+		const MemoryRegion& region = regions[i];
+		MemoryRegionStats& regionStats = stats.regions[i];
+
+		regionStats.slotSize = region.regionSize;
+		regionStats.capacity = region.capacity;
+		regionStats.live = region.live;
+		regionStats.peak = region.peak;
+		regionStats.spills = region.spills;
+		regionStats.allocations = region.allocationCount;
+		regionStats.requestedBytes = region.requestedBytes;
+		regionStats.reservedBytes = region.allocationCount * region.regionSize;
+	}
+
+	stats.largeAllocations = largeAllocations;
+	stats.largeBytes = largeBytes;
+	stats.largePeakBytes = largePeakBytes;
+	stats.largeHugePageBytes = largeHugePageBytes;
+	stats.overflowAllocations = overflowAllocations;
+
+	for (U32 i = 0; i < MemoryTagCount; ++i) { stats.tags[i] = tagStats[i]; }
+
+	return stats;
+}
+
+U8* Memory::ReservePages(U64 size)
+{
+#ifdef NH_PLATFORM_WINDOWS
+	return (U8*)VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+	void* pointer = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	return pointer == MAP_FAILED ? nullptr : (U8*)pointer;
+#endif
+}
+
+bool Memory::CommitPages(void* pointer, U64 size)
+{
+	if (size == 0) { return true; }
+
+#ifdef NH_PLATFORM_WINDOWS
+	return VirtualAlloc(pointer, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+	U64 pageSize = (U64)sysconf(_SC_PAGESIZE);
+	U64 start = (U64)pointer & ~(pageSize - 1);
+	return mprotect((void*)start, (U64)pointer + size - start, PROT_READ | PROT_WRITE) == 0;
+#endif
+}
+
+void Memory::ReleasePages(void* pointer, U64 size)
+{
+#ifdef NH_PLATFORM_WINDOWS
+	VirtualFree(pointer, 0, MEM_RELEASE);
+#else
+	munmap(pointer, size);
+#endif
+}
+
+U8* FrameArena::memory = nullptr;
+U32 FrameArena::frameIndex = 0;
+U64 FrameArena::cursor = 0;
+
+bool FrameArena::Initialize()
+{
+	memory = (U8*)_aligned_malloc(FrameArenaSize * BufferCount, HeaderSize);
+
+	return memory;
+}
+
+void FrameArena::Shutdown()
+{
+	if (memory) { _aligned_free(memory); memory = nullptr; }
+}
+
+void FrameArena::Reset()
+{
+	frameIndex = (frameIndex + 1) % BufferCount;
+	cursor = 0;
+}
+
+bool FrameArena::Contains(void* pointer)
+{
+	//Before Initialize and after Shutdown nothing is frame memory, null would otherwise claim every low address
+	return memory && pointer >= memory && pointer < memory + FrameArenaSize * BufferCount;
+}
+
+void* FrameArena::AllocateInternal(U64 size)
+{
+	if (!memory) { return nullptr; }
+
+	U64 total = NextMultipleOf(size, HeaderSize) + HeaderSize;
+	U64 end = SafeAdd(&cursor, total);
+
+	if (end > FrameArenaSize) { return nullptr; }
+
+	U8* header = memory + frameIndex * FrameArenaSize + end - total;
+	*(U64*)header = total - HeaderSize;
+
+	return header + HeaderSize;
+}
+
+void* FrameArena::ReallocateInternal(void* pointer, U64 size, U64 liveSize)
+{
+	U64 oldSize = AllocationSize(pointer);
+
+	if (size <= oldSize) { return pointer; }
+
+	U8* buffer = memory + frameIndex * FrameArenaSize;
+	U64 newSize = NextMultipleOf(size, HeaderSize);
+
+	//Grow in place if this is still the last allocation in the current buffer
+	if (pointer > buffer && pointer < buffer + FrameArenaSize)
+	{
+		U64 oldEnd = (U8*)pointer - buffer + oldSize;
+		U64 newEnd = oldEnd + newSize - oldSize;
+
+		if (newEnd <= FrameArenaSize && SafeCompareAndExchange(&cursor, newEnd, oldEnd) == oldEnd)
+		{
+			*((U64*)pointer - 2) = newSize;
+			return pointer;
+		}
+	}
+
+	void* dst = AllocateInternal(size);
+	if (dst) { memcpy(dst, pointer, liveSize < oldSize ? liveSize : oldSize); }
+
+	return dst;
+}
+
+U64 FrameArena::AllocationSize(void* pointer)
+{
+	return *((U64*)pointer - 2);
 }
 
-NH_NODISCARD __declspec(allocator) void* operator new(U64 size) { if (size == 0) { return nullptr; } U8* ptr; Memory::Allocate(&ptr, size); return ptr; }
-NH_NODISCARD __declspec(allocator) void* operator new[](U64 size) { if (size == 0) { return nullptr; } U8* ptr; Memory::Allocate(&ptr, size); return ptr; }
-NH_NODISCARD __declspec(allocator) void* operator new(U64 size, Align alignment) { if (size == 0) { return nullptr; } U8* ptr; Memory::Allocate(&ptr, size); return ptr; }
-NH_NODISCARD __declspec(allocator) void* operator new[](U64 size, Align alignment) { if (size == 0) { return nullptr; } U8* ptr; Memory::Allocate(&ptr, size); return ptr; }
+NH_NODISCARD __declspec(allocator) void* operator new(U64 size) { if (size == 0) { return nullptr; } U8* ptr = nullptr; Memory::Allocate(&ptr, size); return ptr; }
+NH_NODISCARD __declspec(allocator) void* operator new[](U64 size) { if (size == 0) { return nullptr; } U8* ptr = nullptr; Memory::Allocate(&ptr, size); return ptr; }
+NH_NODISCARD __declspec(allocator) void* operator new(U64 size, Align alignment) { if (size == 0) { return nullptr; } U8* ptr = nullptr; Memory::AllocateAligned(&ptr, size, (U64)alignment); return ptr; }
+NH_NODISCARD __declspec(allocator) void* operator new[](U64 size, Align alignment) { if (size == 0) { return nullptr; } U8* ptr = nullptr; Memory::AllocateAligned(&ptr, size, (U64)alignment); return ptr; }
 void operator delete(void* ptr) noexcept { Memory::Free(&ptr); }
 void operator delete[](void* ptr) noexcept { Memory::Free(&ptr); }
 void operator delete(void* ptr, Align alignment) noexcept { Memory::Free(&ptr); }
@@ -5,6 +5,7 @@
 
 #include "Multithreading/ThreadSafety.hpp"
 #include <cstringt.h>
+#include <new>
 
 template<class Type, class... Parameters>
 inline Type& Construct(Type* dst, Parameters&&... parameters) noexcept
@@ -29,23 +30,24 @@ inline Type* CopyData(Type* dst, const Type* src, U64 count)
 
 	if (dst > src && dst < src + count)
 	{
-		dst += count - 1;
-		src += count - 1;
-
-		if constexpr (IsNonPrimitive<Type>)
+		if constexpr (IsNonPrimitive<Type> && !IsTriviallyCopyable<Type>)
 		{
+			//Back to front so the overlap is read before it's overwritten
+			dst += count - 1;
+			src += count - 1;
+
 			while (count--) { new (dst--) Type(*src--); }
 
 			return dest;
 		}
 		else
 		{
-			return (Type*)memmove(dst, src, count * size);
+			return (Type*)memmove(dest, src, count * size);
 		}
 	}
 	else
 	{
-		if constexpr (IsNonPrimitive<Type>)
+		if constexpr (IsNonPrimitive<Type> && !IsTriviallyCopyable<Type>)
 		{
 			while (count--) { new (dst++) Type(*src++); }
 
@@ -69,11 +71,12 @@ inline Type* MoveData(Type* dst, Type* src, U64 count)
 
 	if (dst > src && dst < src + count)
 	{
-		dst += count - 1;
-		src += count - 1;
-
-		if constexpr (IsNonPrimitive<Type> && IsMoveConstructible<Type>)
+		if constexpr (IsNonPrimitive<Type> && !IsTriviallyCopyable<Type> && IsMoveConstructible<Type>)
 		{
+			//Back to front so the overlap is read before it's overwritten
+			dst += count - 1;
+			src += count - 1;
+
 			while (count--)
 			{
 				new (dst--) Type(Move(*src));
@@ -85,12 +88,12 @@ inline Type* MoveData(Type* dst, Type* src, U64 count)
 		}
 		else
 		{
-			return (Type*)memmove(dst, src, count * size);
+			return (Type*)memmove(dest, src, count * size);
 		}
 	}
 	else
 	{
-		if constexpr (IsNonPrimitive<Type> && IsMoveConstructible<Type>)
+		if constexpr (IsNonPrimitive<Type> && !IsTriviallyCopyable<Type> && IsMoveConstructible<Type>)
 		{
 			while (count--)
 			{
@@ -112,113 +115,389 @@ NH_API constexpr U64 Kilobytes(U64 n) { return n * 1024Ui64; }
 NH_API constexpr U64 Megabytes(U64 n) { return n * 1024Ui64 * 1024Ui64; }
 NH_API constexpr U64 Gigabytes(U64 n) { return n * 1024Ui64 * 1024Ui64 * 1024Ui64; }
 
+//Default arena size, NH_MEMORY_SIZE in the environment (in megabytes) or the recorded memory profile override it at runtime
 #ifndef MEMORY_SIZE
 static constexpr inline U64 DynamicMemorySize = Gigabytes(1);
 #else
 static constexpr inline U64 DynamicMemorySize = MEMORY_SIZE;
 #endif
 
+#ifndef FRAME_ARENA_SIZE
+static constexpr inline U64 FrameArenaSize = Megabytes(4);
+#else
+static constexpr inline U64 FrameArenaSize = FRAME_ARENA_SIZE;
+#endif
+
 enum class RegionSize : U64
 {
+	B16 = 16,
+	B32 = 32,
+	B64 = 64,
+	B128 = 128,
+	B256 = 256,
+	B512 = 512,
 	KB1 = Kilobytes(1),
 	KB16 = Kilobytes(16),
 	KB256 = Kilobytes(256),
 	MB4 = Megabytes(4),
 };
 
+static constexpr inline U32 RegionSizeCount = 10;
+
+struct Region16b { U8 memory[*RegionSize::B16]; };
+struct Region32b { U8 memory[*RegionSize::B32]; };
+struct Region64b { U8 memory[*RegionSize::B64]; };
+struct Region128b { U8 memory[*RegionSize::B128]; };
+struct Region256b { U8 memory[*RegionSize::B256]; };
+struct Region512b { U8 memory[*RegionSize::B512]; };
 struct Region1kb { U8 memory[*RegionSize::KB1]; };
 struct Region16kb { U8 memory[*RegionSize::KB16]; };
 struct Region256kb { U8 memory[*RegionSize::KB256]; };
 struct Region4mb { U8 memory[*RegionSize::MB4]; };
 
+/// <summary>
+/// The subsystem an allocation is charged to, Current uses the tag of the innermost MemoryTagScope on this thread
+/// </summary>
+enum class MemoryTag : U8
+{
+	General,
+	Renderer,
+	Resources,
+	Audio,
+	UI,
+	Physics,
+	Gameplay,
+
+	Count,
+	Current = 0xFF
+};
+
+static constexpr inline U32 MemoryTagCount = (U32)MemoryTag::Count;
+
+/// <summary>
+/// What the allocation sampling interval counts, see Memory::SetSampling
+/// </summary>
+enum class MemorySampling : U8
+{
+	Off,
+	Allocations,	//Samples every Nth allocation
+	Bytes,			//Samples the allocation that crosses every N bytes, so big allocations are sampled more often
+};
+
 struct NH_API MemoryRegion
 {
 private:
-	void Create(U8* pointer, U32 regionSize, U32 cap, U32* indices);
-	bool Allocate(void** pointer);
-	bool Reallocate(void** src, void** dst);
+	void Create(U8* pointer, U32 regionSize, U32 cap, U32* indices, MemoryTag* tags);
+	bool Allocate(void** pointer, U64 size, MemoryTag tag);
 	void Free(void** pointer);
+	MemoryTag Tag(void* pointer);
 	bool WithinRegion(void* pointer);
 	U32 GetFree();
 	void Release(U32 index);
-	bool Full();
+	U32 Acquire(U32* indices, U32 count);
+	void Flush(const U32* indices, U32 count);
+	void Publish();
+	bool Commit(U32 slotCount);
 
+	alignas(CacheLineSize) SpinLock lock;
 	U32 capacity = 0;
 	U32 freeCount = 0;
 	U32 lastFree = 0;
 	U32 regionSize = 0;
 	U32* freeIndices = nullptr;
+	MemoryTag* tags = nullptr;		//Owner of each slot
 	U8* region = nullptr;
+	U64 committed = 0;
+	U64 committedIndices = 0;
+	U64 committedTags = 0;
+	bool cached = false;
+
+	//Statistics, kept off the lock's cache line, threads add to them in batches when their magazine refills or flushes
+	alignas(CacheLineSize) U64 live = 0;
+	U64 peak = 0;
+	U64 spills = 0;
+	U64 allocationCount = 0;
+	U64 requestedBytes = 0;
 
 	friend class Memory;
+	friend struct MemoryMagazine;
+};
+
+struct NH_API MemoryRegionStats
+{
+	U64 slotSize = 0;
+	U64 capacity = 0;		//Slots in the region
+	U64 live = 0;			//Slots currently handed out
+	U64 peak = 0;
+	U64 spills = 0;			//Allocations that found the region full and went to a bigger slot or mapped pages
+	U64 allocations = 0;	//Lifetime allocations, requestedBytes and reservedBytes are totals over these
+	U64 requestedBytes = 0;
+	U64 reservedBytes = 0;	//reservedBytes - requestedBytes is the internal fragmentation
+};
+
+struct NH_API MemoryTagStats
+{
+	U64 live = 0;		//Bytes of slots and mapped pages charged to the tag
+	U64 peak = 0;
+	U64 budget = 0;		//Soft limit, zero if there is none
+};
+
+struct NH_API MemoryStats
+{
+	MemoryRegionStats regions[RegionSizeCount];	//Smallest slot size first
+	MemoryTagStats tags[MemoryTagCount];
+
+	U64 largeAllocations = 0;	//Live allocations in mapped pages, bigger than the 4mb region or spilled out of the regions
+	U64 largeBytes = 0;			//Bytes mapped for them, including headers and page rounding
+	U64 largePeakBytes = 0;
+	U64 largeHugePageBytes = 0;	//Part of largeBytes backed by explicit huge pages
+	U64 overflowAllocations = 0;	//Allocations that spilled past the 4mb region into mapped pages
 };
 
 class NH_API Memory
 {
 public:
-	template<Pointer Type> static void Allocate(Type* pointer);
-	template<Pointer Type> static U64 Allocate(Type* pointer, U64 count);
-	template<Pointer Type> static U64 Reallocate(Type* pointer, U64 count);
+	template<Pointer Type> static void Allocate(Type* pointer, MemoryTag tag = MemoryTag::Current);
+	template<Pointer Type> static U64 Allocate(Type* pointer, U64 count, MemoryTag tag = MemoryTag::Current);
+	template<Pointer Type> static void AllocateZeroed(Type* pointer, MemoryTag tag = MemoryTag::Current);
+	template<Pointer Type> static U64 AllocateZeroed(Type* pointer, U64 count, MemoryTag tag = MemoryTag::Current);
+	template<Pointer Type> static U64 AllocateAligned(Type* pointer, U64 count, U64 alignment, MemoryTag tag = MemoryTag::Current);
+	template<Pointer Type> static U64 Reallocate(Type* pointer, U64 count, U64 liveCount = U64_MAX, MemoryTag tag = MemoryTag::Current);
 	template<Pointer Type> static void Free(Type* pointer);
 
 	static bool IsAllocated(void* pointer);
 
+	/// <summary>
+	/// Slot counts include this thread's latest allocations, other threads' show up once their magazines refill or flush
+	/// </summary>
+	static MemoryStats Statistics();
+
+	/// <summary>
+	/// Sets a soft limit on the bytes charged to tag, crossing it logs a warning
+	/// </summary>
+	/// <param name="tag:">The tag to limit</param>
+	/// <param name="bytes:">The limit, zero removes it</param>
+	/// <param name="breakOnExceed:">Also hit a breakpoint in debug builds when crossing the limit</param>
+	static void SetBudget(MemoryTag tag, U64 bytes, bool breakOnExceed = false);
+
+	/// <summary>
+	/// Sets the tag MemoryTag::Current resolves to on this thread, prefer MemoryTagScope
+	/// </summary>
+	/// <returns>The previous tag</returns>
+	static MemoryTag SetTag(MemoryTag tag);
+
+	/// <summary>
+	/// Turns on sampling, each sampled allocation is sent to Tracy's memory profiler with its callstack under the
+	/// "Sampled Allocations" pool, its call stack tree over a frame's time range shows which code paths allocate
+	/// </summary>
+	/// <param name="mode:">What interval counts, Off turns sampling off</param>
+	/// <param name="interval:">Allocations or bytes between samples</param>
+	static void SetSampling(MemorySampling mode, U64 interval);
+
+	static constexpr inline U64 MaxAlignment = Kilobytes(4);
+
 private:
 	static bool Initialize();
 	static void Shutdown();
+	static void Update();
 
-	static U64 AllocateInternal(void** pointer, U64 size, U64 typeSize);
-	static U64 ReallocateInternal(void** src, void** dst, U64 size, U64 typeSize);
+	static U64 AllocateInternal(void** pointer, U64 size, U64 typeSize, MemoryTag tag);
+	static U64 AllocateSlot(void** pointer, U64 size, MemoryTag tag);
+	static U64 AllocateAlignedInternal(void** pointer, U64 size, U64 typeSize, U64 alignment, MemoryTag tag);
+	static U64 ReallocateInternal(void** pointer, U64 size, U64 liveSize, U64 typeSize);
 	static void FreeInternal(void** pointer);
 
+	static void Track(MemoryTag tag, I64 bytes);
+	static void Publish();
+	static void Sample(void* pointer, U64 size);
+
+	static U64 AllocateLarge(void** pointer, U64 size, MemoryTag tag);
+	static U64 ReallocateLarge(void** pointer, U64 size, U64 liveSize);
+	static void FreeLarge(void** pointer);
+
+	static U32 RegionIndex(U64 size);
+	static MemoryRegion* GetRegion(void* pointer);
+
+	static U8* ReservePages(U64 size);
+	static bool CommitPages(void* pointer, U64 size);
+	static void ReleasePages(void* pointer, U64 size);
+
+	static constexpr inline U64 CommitGranularity = Kilobytes(64);
+	static constexpr inline U64 LargeHeaderSize = MaxAlignment;	//Keeps large allocations page aligned
+	static constexpr inline U8 FreedPattern = 0xDD;	//Freed slots are filled with this in debug builds
+	static constexpr inline I32 SampleDepth = 16;	//Callstack frames captured per sample
+
+	static constexpr inline U32 SmallRegionCount = 6;	//16b, 32b, 64b, 128b, 256b, 512b
+	static constexpr inline U32 RegionCount = SmallRegionCount + 4;
+	static_assert(RegionCount == RegionSizeCount);
+
 	static U32 allocations;
 	static U8* memory;
+	static U64 arenaSize;
 
-	static MemoryRegion region1kb;
-	static MemoryRegion region16kb;
-	static MemoryRegion region256kb;
-	static MemoryRegion region4mb;
+	//Ordered from smallest to largest slot size
+	static MemoryRegion regions[RegionCount];
 
 	static bool initialized;
 
+	static U64 largePageSize;	//Zero once huge pages turn out to be unavailable
+	static U64 largeAllocations;
+	static U64 largeBytes;
+	static U64 largePeakBytes;
+	static U64 largeHugePageBytes;
+	static U64 overflowAllocations;
+
+	static MemoryTagStats tagStats[MemoryTagCount];
+	static bool breakOnBudget[MemoryTagCount];
+
+	static MemorySampling samplingMode;
+	static U64 samplingInterval;
+	static U64 frameSamples;
+	static U64 frameSampledBytes;
+
 	friend class Engine;
+	friend class FrameArena;
 	friend struct MemoryRegion;
+	friend struct MemoryMagazine;
 
 	STATIC_CLASS(Memory);
 };
 
+/// <summary>
+/// Charges allocations made on this thread to tag until the scope ends
+/// </summary>
+struct MemoryTagScope
+{
+	MemoryTagScope(MemoryTag tag) : previous(Memory::SetTag(tag)) {}
+	~MemoryTagScope() { Memory::SetTag(previous); }
+
+	MemoryTagScope(const MemoryTagScope&) = delete;
+	MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+private:
+	MemoryTag previous;
+};
+
+struct FrameTag{} static inline constexpr FRAME;
+
+/// <summary>
+/// Bump allocator for temporaries that only need to live for the current frame, allocations are never freed individually,
+/// the whole buffer is reset when it comes back around, BufferCount frames later
+/// <para/>Memory::Reallocate keeps frame allocations in the arena, Memory::Free on them does nothing
+/// </summary>
+class NH_API FrameArena
+{
+public:
+	template<Pointer Type> static U64 Allocate(Type* pointer, U64 count);
+
+	static bool Contains(void* pointer);
+
+	static constexpr inline U32 BufferCount = 3;
+
+private:
+	static bool Initialize();
+	static void Shutdown();
+	static void Reset();
+
+	static void* AllocateInternal(U64 size);
+	static void* ReallocateInternal(void* pointer, U64 size, U64 liveSize);
+	static U64 AllocationSize(void* pointer);
+
+	static constexpr inline U64 HeaderSize = 16;
+
+	static U8* memory;
+	static U32 frameIndex;
+	static U64 cursor;
+
+	friend class Engine;
+	friend class Memory;
+
+	STATIC_CLASS(FrameArena);
+};
+
 template<Pointer Type>
-inline void Memory::Allocate(Type* pointer)
+inline void Memory::Allocate(Type* pointer, MemoryTag tag)
 {
 	static bool b = Initialize();
 
 	if (IsAllocated(*pointer)) { return; }
 
-	AllocateInternal((void**)pointer, sizeof(RemovePointer<Type>), sizeof(RemovePointer<Type>));
+	AllocateInternal((void**)pointer, sizeof(RemovePointer<Type>), sizeof(RemovePointer<Type>), tag);
 }
 
 template<Pointer Type>
-inline U64 Memory::Allocate(Type* pointer, U64 count)
+inline U64 Memory::Allocate(Type* pointer, U64 count, MemoryTag tag)
 {
 	static bool b = Initialize();
 
 	if (IsAllocated(*pointer)) { return Reallocate<Type>(pointer, count); }
 
-	return AllocateInternal((void**)pointer, sizeof(RemovePointer<Type>) * count, sizeof(RemovePointer<Type>));
+	return AllocateInternal((void**)pointer, sizeof(RemovePointer<Type>) * count, sizeof(RemovePointer<Type>), tag);
+}
+
+/// <summary>
+/// Allocates like Allocate, but the memory is cleared, freed memory is not zeroed so use this when the contents need to start out zero
+/// </summary>
+template<Pointer Type>
+inline void Memory::AllocateZeroed(Type* pointer, MemoryTag tag)
+{
+	Allocate<Type>(pointer, tag);
+
+	if (*pointer) { memset(*pointer, 0, sizeof(RemovePointer<Type>)); }
 }
 
+/// <summary>
+/// Allocates like Allocate, but the memory is cleared, freed memory is not zeroed so use this when the contents need to start out zero
+/// </summary>
+/// <param name="pointer:">The allocation, an existing allocation gets resized and cleared</param>
+/// <param name="count:">The amount of elements needed</param>
+/// <returns>The amount of elements that fit in the allocation</returns>
 template<Pointer Type>
-inline U64 Memory::Reallocate(Type* pointer, U64 count)
+inline U64 Memory::AllocateZeroed(Type* pointer, U64 count, MemoryTag tag)
+{
+	U64 capacity = Allocate<Type>(pointer, count, tag);
+
+	if (*pointer) { memset(*pointer, 0, sizeof(RemovePointer<Type>) * capacity); }
+
+	return capacity;
+}
+
+/// <summary>
+/// Allocates with at least the given alignment, Allocate already aligns to the type, this is for over-aligned buffers
+/// <para/>Reallocating keeps the alignment, slots only ever move to bigger slots
+/// </summary>
+/// <param name="pointer:">The allocation, an existing allocation gets resized instead</param>
+/// <param name="count:">The amount of elements needed</param>
+/// <param name="alignment:">A power of two no bigger than MaxAlignment</param>
+/// <returns>The amount of elements that fit in the allocation, zero if the alignment isn't supported</returns>
+template<Pointer Type>
+inline U64 Memory::AllocateAligned(Type* pointer, U64 count, U64 alignment, MemoryTag tag)
 {
 	static bool b = Initialize();
 
-	if (!IsAllocated(*pointer)) { return Allocate<Type>(pointer, count); }
-	
-	U64 size = sizeof(RemovePointer<Type>) * count;
+	if (IsAllocated(*pointer)) { return Reallocate<Type>(pointer, count); }
 
-	Type temp = nullptr;
+	return AllocateAlignedInternal((void**)pointer, sizeof(RemovePointer<Type>) * count, sizeof(RemovePointer<Type>), alignment, tag);
+}
 
-	return ReallocateInternal((void**)pointer, (void**)&temp, sizeof(RemovePointer<Type>) * count, sizeof(RemovePointer<Type>));
+/// <summary>
+/// Resizes an allocation to fit count elements, keeping the first liveCount elements
+/// </summary>
+/// <param name="pointer:">The allocation, allocates a new one if nullptr</param>
+/// <param name="count:">The amount of elements needed</param>
+/// <param name="liveCount:">The amount of elements currently in use that need to be kept, defaults to all of them</param>
+/// <param name="tag:">Only used for new allocations, moved allocations keep their tag</param>
+/// <returns>The amount of elements that fit in the allocation</returns>
+template<Pointer Type>
+inline U64 Memory::Reallocate(Type* pointer, U64 count, U64 liveCount, MemoryTag tag)
+{
+	static bool b = Initialize();
+
+	if (*pointer == nullptr) { return Allocate<Type>(pointer, count, tag); }
+
+	constexpr U64 typeSize = sizeof(RemovePointer<Type>);
+
+	return ReallocateInternal((void**)pointer, typeSize * count, liveCount < U64_MAX / typeSize ? typeSize * liveCount : U64_MAX, typeSize);
 }
 
 template<Pointer Type>
@@ -227,7 +506,22 @@ inline void Memory::Free(Type* pointer)
 	FreeInternal((void**)pointer);
 }
 
-enum class Align : U64 {};
+template<Pointer Type>
+inline U64 FrameArena::Allocate(Type* pointer, U64 count)
+{
+	//Frame allocations are only aligned to the header
+	if constexpr (alignof(RemovePointer<Type>) > HeaderSize) { return Memory::Allocate(pointer, count); }
+
+	void* allocation = AllocateInternal(sizeof(RemovePointer<Type>) * count);
+
+	//Arena is full or not initialized yet
+	if (allocation == nullptr) { return Memory::Allocate(pointer, count); }
+
+	*pointer = (Type)allocation;
+	return AllocationSize(allocation) / sizeof(RemovePointer<Type>);
+}
+
+using Align = std::align_val_t;
 
 NH_NODISCARD __declspec(allocator) void* operator new(U64 size);
 NH_NODISCARD __declspec(allocator) void* operator new[](U64 size);
@@ -2,7 +2,7 @@
 
 #include "Defines.hpp"
 
-#include "Containers/Vector.hpp"
+#include "Containers/SmallVector.hpp"
 
 struct VkBuffer_T;
 struct VkSampler_T;
@@ -89,7 +89,7 @@ private:
 	VkDescriptorSetLayout_T* vkDescriptorLayout;
 	VkDescriptorSet_T* vkDescriptorSet;
 
-	Vector<DescriptorBinding> bindings;
+	SmallVector<DescriptorBinding, 8> bindings;
 	Vector<VkWriteDescriptorSet> writes;
 
 	bool bindless;
@@ -22,6 +22,8 @@
 
 #include "vma/vk_mem_alloc.h"
 
+static_assert(FrameArena::BufferCount >= MaxSwapchainImages, "Frame allocations must outlive every frame in flight");
+
 VmaAllocator Renderer::vmaAllocator;
 VkAllocationCallbacks* Renderer::allocationCallbacks;
 VkDescriptorPool Renderer::vkDescriptorPool = VK_NULL_HANDLE;
@@ -54,6 +56,7 @@ U64 Renderer::transferWaitValues[MaxSwapchainImages];
 bool Renderer::Initialize(const StringView& name, U32 version)
 {
 	Logger::Trace("Initializing Renderer...");
+	MemoryTagScope memoryTag(MemoryTag::Renderer);
 
 	if (!instance.Create(name, version)) { Logger::Fatal("Failed To Create Vulkan Instance!"); return false; }
 	if (!device.Create()) { Logger::Fatal("Failed To Create Vulkan Device!"); return false; }
@@ -134,6 +137,7 @@ void Renderer::Shutdown()
 void Renderer::Update()
 {
 	ZoneScopedN("RenderMain");
+	MemoryTagScope memoryTag(MemoryTag::Renderer);
 
 	if (!Synchronize()) { return; }
 
@@ -162,6 +162,8 @@ ElementRef::operator bool() const
 
 bool UI::Initialize()
 {
+	MemoryTagScope memoryTag(MemoryTag::UI);
+
 	PipelineLayout uiPipelineLayout;
 
 	uiPipelineLayout.Create({ Resources::DummyDescriptorSet(), Resources::BindlessTexturesDescriptorSet() });
@@ -268,6 +270,8 @@ void UI::Shutdown()
 
 void UI::Update()
 {
+	MemoryTagScope memoryTag(MemoryTag::UI);
+
 	Vector2 mousePosition = Input::MousePosition() / (Vector2)Renderer::RenderSize() * 2.0f - Vector2::One;
 
 	for (Element& element : elements)
@@ -47,7 +47,7 @@ bool Collider::Update(Camera& camera, Vector<Entity>& entities)
 #ifdef NH_DEBUG
 	for (const Collider& collider : components)
 	{
-		LineRenderer::DrawLine({ collider.lowerBound, { collider.lowerBound.x, collider.upperBound.y }, collider.upperBound, { collider.upperBound.x, collider.lowerBound.y } }, true, { 0.0f, 1.0f, 0.0f, 1.0f });
+		LineRenderer::DrawLine({ FRAME, { collider.lowerBound, { collider.lowerBound.x, collider.upperBound.y }, collider.upperBound, { collider.upperBound.x, collider.lowerBound.y } } }, true, { 0.0f, 1.0f, 0.0f, 1.0f });
 	}
 #endif
 
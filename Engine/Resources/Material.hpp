@@ -7,7 +7,7 @@
 #include "Rendering/PipelineLayout.hpp"
 #include "Rendering/Pipeline.hpp"
 #include "Rendering/CommandBuffer.hpp"
-#include "Containers/Vector.hpp"
+#include "Containers/SmallVector.hpp"
 
 struct VkDescriptorSet_T;
 
@@ -55,6 +55,6 @@ private:
 	Buffer vertexBuffer;
 	Buffer indexBuffer;
 	Buffer instanceBuffers[MaxSwapchainImages];
-	Vector<VkDescriptorSet_T*> sets;
-	Vector<PushConstant> pushConstants;
+	SmallVector<VkDescriptorSet_T*, 4> sets;
+	SmallVector<PushConstant, 4> pushConstants;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Rendering/Renderer.hpp"
 #include "Containers/Stack.hpp"
 #include "Containers/Pair.hpp"
+#include "Containers/StringBuilder.hpp"
 #include "Platform/Platform.hpp"
 
 #include "tracy/Tracy.hpp"
@@ -50,15 +51,17 @@ DescriptorSet Resources::bindlessTexturesSet;
 ResourceRef<Texture> Resources::whiteTexture;
 ResourceRef<Texture> Resources::placeholderTexture;
 
-Hashmap<String, Resource<Texture>> Resources::textures(1024);
-Hashmap<String, Resource<Font>> Resources::fonts(16);
-Hashmap<String, Resource<AudioClip>> Resources::audioClips(1024);
+//Fixed, handles double as bindless indices and ResourceRefs point straight into the cells
+Hashmap<String, Resource<Texture>> Resources::textures(1024, true);
+Hashmap<String, Resource<Font>> Resources::fonts(16, true);
+Hashmap<String, Resource<AudioClip>> Resources::audioClips(1024, true);
 
 Queue<ResourceRef<Texture>> Resources::bindlessTexturesToUpdate(128);
 
 bool Resources::Initialize()
 {
 	Logger::Trace("Initializing Resources...");
+	MemoryTagScope memoryTag(MemoryTag::Resources);
 
 	Platform::OnDragDrop += UploadResource;
 
@@ -106,11 +109,12 @@ void Resources::Shutdown()
 void Resources::Update()
 {
 	ZoneScopedN("ResourcesUpdate");
+	MemoryTagScope memoryTag(MemoryTag::Resources);
 
 	if (bindlessTexturesToUpdate.Size())
 	{
-		Vector<VkWriteDescriptorSet> writes(bindlessTexturesToUpdate.Size());
-		Vector<VkDescriptorImageInfo> textureData(bindlessTexturesToUpdate.Size());
+		Vector<VkWriteDescriptorSet> writes(FRAME, bindlessTexturesToUpdate.Size());
+		Vector<VkDescriptorImageInfo> textureData(FRAME, bindlessTexturesToUpdate.Size());
 
 		ResourceRef<Texture> texture;
 		while (bindlessTexturesToUpdate.Pop(texture))
@@ -146,7 +150,10 @@ ResourceRef<Texture> Resources::LoadTexture(const String& path, const Sampler& s
 	if (path.Blank()) { Logger::Error("Blank Path Passed To LoadTexture!"); return nullptr; }
 
 	U64 handle;
-	Resource<Texture>& texture = *textures.Request(path, handle);
+	Resource<Texture>* entry = textures.Request(path, handle);
+	if (!entry) { Logger::Error("Too Many Textures Loaded!"); return nullptr; }
+
+	Resource<Texture>& texture = *entry;
 
 	if (!texture->name.Blank()) { return { texture, handle }; }
 	
@@ -200,7 +207,10 @@ ResourceRef<Font> Resources::LoadFont(const String& path)
 	if (path.Blank()) { Logger::Error("Blank Path Passed To LoadFont!"); return nullptr; }
 
 	U64 handle;
-	Resource<Font>& font = *fonts.Request(path, handle);
+	Resource<Font>* entry = fonts.Request(path, handle);
+	if (!entry) { Logger::Error("Too Many Fonts Loaded!"); return nullptr; }
+
+	Resource<Font>& font = *entry;
 
 	if (!font->name.Blank()) { return { font, handle }; }
 
@@ -234,7 +244,17 @@ ResourceRef<Font> Resources::LoadFont(const String& path)
 		file.Read(atlas, width * height * 4 * sizeof(F32));
 
 		U64 textureHandle;
-		Resource<Texture>& texture = *textures.Request(path, textureHandle);
+		Resource<Texture>* textureEntry = textures.Request(path, textureHandle);
+		if (!textureEntry)
+		{
+			Logger::Error("Too Many Textures Loaded!");
+			Memory::Free(&atlas);
+			fonts.Remove(handle);
+			file.Close();
+			return nullptr;
+		}
+
+		Resource<Texture>& texture = *textureEntry;
 
 		texture->name = path.FileName().Append("_texture");
 		texture->width = width;
@@ -274,7 +294,10 @@ ResourceRef<AudioClip> Resources::LoadAudio(const String& path)
 	if (path.Blank()) { Logger::Error("Blank Path Passed To LoadAudio!"); return nullptr; }
 
 	U64 handle;
-	Resource<AudioClip>& audioClip = *audioClips.Request(path, handle);
+	Resource<AudioClip>* entry = audioClips.Request(path, handle);
+	if (!entry) { Logger::Error("Too Many Audio Clips Loaded!"); return nullptr; }
+
+	Resource<AudioClip>& audioClip = *entry;
 
 	if (!audioClip->name.Blank()) { return { audioClip, handle }; }
 
@@ -387,7 +410,8 @@ String Resources::UploadTexture(const String& path)
 		texture.depth = 1;
 		texture.format = TextureFormat::R8G8B8A8Srgb;
 
-		String newPath = path.FileName().Prepend("textures/").Append(".nht");
+		StringBuilder builder;
+		String newPath = builder.Append("textures/", texture.name, ".nht").ToString();
 		file.Open(newPath, FILE_OPEN_RESOURCE_WRITE);
 
 		file.Write("NHT");
@@ -433,7 +457,7 @@ String Resources::UploadFont(const String& path)
 		file.Close();
 
 		Font* font;
-		Memory::Allocate(&font);
+		Memory::AllocateZeroed(&font);
 		font->name = path.FileName();
 
 		const U8* fontData = (const U8*)data.Data();
@@ -448,7 +472,7 @@ String Resources::UploadFont(const String& path)
 		font->LoadData(&info, glyphSize);
 
 		F32* atlas;
-		Memory::Allocate(&atlas, rowWidth * columnHeight * 4);
+		Memory::AllocateZeroed(&atlas, rowWidth * columnHeight * 4);
 
 		F32* bitmap;
 		Memory::Allocate(&bitmap, glyphSize * glyphSize * 4);
@@ -489,7 +513,8 @@ String Resources::UploadFont(const String& path)
 
 		font->CreateKerning(&info, glyphSize, glyphToCodepoint);
 
-		String newPath = path.FileName().Prepend("fonts/").Append(".nhf");
+		StringBuilder builder;
+		String newPath = builder.Append("fonts/", font->name, ".nhf").ToString();
 		file.Open(newPath, FILE_OPEN_RESOURCE_WRITE);
 
 		file.Write("NHF");
@@ -602,7 +627,8 @@ String Resources::UploadAudio(const String& path)
 		} break;
 		}
 
-		String newPath = path.FileName().Prepend("audio/").Append(".nha");
+		StringBuilder builder;
+		String newPath = builder.Append("audio/", clip.name, ".nha").ToString();
 		file.Open(newPath, FILE_OPEN_RESOURCE_WRITE);
 
 		file.Write("NHA");
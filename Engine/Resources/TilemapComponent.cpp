@@ -185,7 +185,7 @@ ComponentRef<Tilemap> Tilemap::AddTo(const EntityRef& entity, U32 width, U32 hei
 	
 	instanceData.Push({ depth, nextOffset });
 
-	Memory::Allocate(&tilemap.tileArray, tmd.width * tmd.height);
+	Memory::AllocateZeroed(&tilemap.tileArray, tmd.width * tmd.height);
 
 	U16* tiles;
 	Memory::Allocate(&tiles, tmd.width * tmd.height);
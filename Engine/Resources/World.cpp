@@ -16,6 +16,8 @@ Camera World::camera;
 
 bool World::Initialize()
 {
+	MemoryTagScope memoryTag(MemoryTag::Gameplay);
+
 	InitializeFns();
 
 	return true;
@@ -31,6 +33,7 @@ void World::Shutdown()
 void World::Update()
 {
 	ZoneScopedN("Scene");
+	MemoryTagScope memoryTag(MemoryTag::Gameplay);
 
 	camera.Update();
 	UpdateFns(camera, entities);
@@ -178,6 +178,9 @@ template <class Type> concept CopyConstructible = IsCopyConstructible<Type>;
 template <class Type> constexpr const bool IsDestructible = __is_destructible(Type);
 template <class Type> concept Destructible = IsDestructible<Type>;
 
+template <class Type> constexpr const bool IsTriviallyCopyable = __is_trivially_copyable(Type);
+template <class Type> concept TriviallyCopyable = IsTriviallyCopyable<Type>;
+
 template <class Type> constexpr const bool IsCopyAssignable = __is_assignable(AddLvalReference<Type>, AddLvalReference<const Type>);
 template <class Type> concept CopyAssignable = IsCopyAssignable<Type>;
 